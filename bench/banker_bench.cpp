@@ -0,0 +1,251 @@
+// bench/banker_bench.cpp
+// Banker's-algorithm admission. TextbookBanker keeps one row per process
+// and, for every request, grants it tentatively and looks for a safe
+// order by scanning for any unfinished process whose need fits, one at a
+// time. ResourcePool keeps the matrices by column, first tries the two
+// checks that need no search, and otherwise finishes every fitting
+// process per round. Part one times the full safety check, part two a
+// mixed stream of single-unit requests and releases.
+//
+// Usage: banker_bench [requests]
+#include "resource/resource_pool.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace os_sim;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr size_t kClasses = 32;
+constexpr size_t kProcessCounts[] = {256, 1024, 4096};
+constexpr ResourceUnits kMaxClaim = 8;
+
+class TextbookBanker {
+public:
+    TextbookBanker(size_t processes, const std::vector<ResourceUnits>& total)
+        : available_(total), allocation_(processes, std::vector<ResourceUnits>(total.size())),
+          need_(processes, std::vector<ResourceUnits>(total.size())) {}
+
+    void declareClaim(size_t process, const std::vector<ResourceUnits>& claim) {
+        need_[process] = claim;
+    }
+
+    bool allocate(size_t process, size_t resource_class, ResourceUnits units) {
+        if (units > available_[resource_class] || units > need_[process][resource_class]) {
+            return false;
+        }
+        available_[resource_class] -= units;
+        allocation_[process][resource_class] += units;
+        need_[process][resource_class] -= units;
+        if (isSafe()) {
+            return true;
+        }
+        available_[resource_class] += units;
+        allocation_[process][resource_class] -= units;
+        need_[process][resource_class] += units;
+        return false;
+    }
+
+    void release(size_t process, size_t resource_class, ResourceUnits units) {
+        available_[resource_class] += units;
+        allocation_[process][resource_class] -= units;
+        need_[process][resource_class] += units;
+    }
+
+    ResourceUnits getAllocated(size_t process, size_t resource_class) const {
+        return allocation_[process][resource_class];
+    }
+
+    bool isSafe() const {
+        std::vector<ResourceUnits> work = available_;
+        std::vector<bool> finished(need_.size(), false);
+        for (size_t done = 0; done < need_.size();) {
+            bool progress = false;
+            for (size_t p = 0; p < need_.size(); ++p) {
+                if (finished[p] || !fits(need_[p], work)) {
+                    continue;
+                }
+                for (size_t c = 0; c < work.size(); ++c) {
+                    work[c] += allocation_[p][c];
+                }
+                finished[p] = true;
+                progress = true;
+                ++done;
+            }
+            if (!progress) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    static bool fits(const std::vector<ResourceUnits>& need,
+                     const std::vector<ResourceUnits>& work) {
+        for (size_t c = 0; c < need.size(); ++c) {
+            if (need[c] > work[c]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::vector<ResourceUnits> available_;
+    std::vector<std::vector<ResourceUnits>> allocation_;
+    std::vector<std::vector<ResourceUnits>> need_;
+};
+
+struct Request {
+    size_t process;
+    size_t resource_class;
+    bool release;
+};
+
+// Claims up to kMaxClaim per class, with about two thirds of all claims
+// covered by the totals so no process can be admitted blindly
+std::vector<std::vector<ResourceUnits>> makeClaims(size_t processes, std::mt19937& rng) {
+    std::uniform_int_distribution<ResourceUnits> units(0, kMaxClaim);
+    std::vector<std::vector<ResourceUnits>> claims(processes, std::vector<ResourceUnits>(kClasses));
+    for (auto& claim : claims) {
+        for (auto& value : claim) {
+            value = units(rng);
+        }
+    }
+    return claims;
+}
+
+std::vector<Request> makeRequests(size_t processes, size_t count, std::mt19937& rng) {
+    std::uniform_int_distribution<size_t> process(0, processes - 1);
+    std::uniform_int_distribution<size_t> resource_class(0, kClasses - 1);
+    std::vector<Request> requests;
+    for (size_t i = 0; i < count; ++i) {
+        requests.push_back({process(rng), resource_class(rng), rng() % 3 == 0});
+    }
+    return requests;
+}
+
+template<class Banker>
+void setUp(Banker& banker, const std::vector<std::vector<ResourceUnits>>& claims,
+           std::mt19937& rng) {
+    for (size_t p = 0; p < claims.size(); ++p) {
+        banker.declareClaim(p, claims[p]);
+    }
+    // Start part way through the claims
+    for (size_t p = 0; p < claims.size(); ++p) {
+        for (size_t c = 0; c < kClasses; ++c) {
+            if (claims[p][c] > 0) {
+                banker.allocate(p, c, static_cast<ResourceUnits>(rng() % (claims[p][c] / 2 + 1)));
+            }
+        }
+    }
+}
+
+template<class Banker>
+double nsPerRequest(Banker& banker, const std::vector<Request>& requests, size_t& granted) {
+    auto start = Clock::now();
+    for (const auto& request : requests) {
+        if (request.release) {
+            if (banker.getAllocated(request.process, request.resource_class) > 0) {
+                banker.release(request.process, request.resource_class, 1);
+            }
+        } else if (banker.allocate(request.process, request.resource_class, 1)) {
+            ++granted;
+        }
+    }
+    std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+    return elapsed.count() / requests.size();
+}
+
+template<class Banker>
+double nsPerCheck(const Banker& banker, size_t checks) {
+    size_t safe = 0;
+    auto start = Clock::now();
+    for (size_t i = 0; i < checks; ++i) {
+        safe += banker.isSafe();
+    }
+    std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+    if (safe != checks) {
+        std::cerr << "unsafe state\n";
+    }
+    return elapsed.count() / checks;
+}
+
+// Adapts ResourcePool to the process-index calls above
+class PoolBanker {
+public:
+    explicit PoolBanker(const std::vector<ResourceUnits>& total) : pool_(total.size()) {
+        for (size_t c = 0; c < total.size(); ++c) {
+            pool_.setTotal(c, total[c]);
+        }
+    }
+
+    void declareClaim(size_t process, const std::vector<ResourceUnits>& claim) {
+        pool_.declareClaim(static_cast<ProcessID>(process), claim);
+    }
+    bool allocate(size_t process, size_t resource_class, ResourceUnits units) {
+        return pool_.allocate(static_cast<ProcessID>(process), resource_class, units) ==
+               ErrorCode::SUCCESS;
+    }
+    void release(size_t process, size_t resource_class, ResourceUnits units) {
+        pool_.release(static_cast<ProcessID>(process), resource_class, units);
+    }
+    ResourceUnits getAllocated(size_t process, size_t resource_class) const {
+        return pool_.getAllocated(static_cast<ProcessID>(process), resource_class);
+    }
+    bool isSafe() const { return pool_.isSafe(); }
+
+private:
+    ResourcePool pool_;
+};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t request_count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20000;
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << kClasses << " resource classes, ns per call\n\n";
+    std::cout << std::setw(9) << "Processes" << " | " << std::setw(12) << "check" << " | "
+              << std::setw(12) << "pool check" << " | " << std::setw(12) << "request"
+              << " | " << std::setw(12) << "pool request" << " | " << std::setw(7) << "granted"
+              << "\n";
+    std::cout << std::string(80, '-') << "\n";
+
+    for (size_t processes : kProcessCounts) {
+        std::mt19937 rng(42);
+        auto claims = makeClaims(processes, rng);
+        std::vector<ResourceUnits> total(kClasses,
+                                         static_cast<ResourceUnits>(processes * kMaxClaim / 3));
+        auto requests = makeRequests(processes, request_count, rng);
+
+        std::mt19937 textbook_rng(7);
+        TextbookBanker textbook(processes, total);
+        setUp(textbook, claims, textbook_rng);
+        std::mt19937 pool_rng(7);
+        PoolBanker pool(total);
+        setUp(pool, claims, pool_rng);
+
+        size_t checks = std::max<size_t>(1, 4000000 / processes / kClasses);
+        double textbook_check = nsPerCheck(textbook, checks);
+        double pool_check = nsPerCheck(pool, checks);
+
+        size_t textbook_granted = 0;
+        size_t pool_granted = 0;
+        double textbook_request = nsPerRequest(textbook, requests, textbook_granted);
+        double pool_request = nsPerRequest(pool, requests, pool_granted);
+        if (textbook_granted != pool_granted) {
+            std::cerr << "granted " << textbook_granted << " vs " << pool_granted << "\n";
+        }
+
+        std::cout << std::setw(9) << processes << " | " << std::setw(12) << textbook_check
+                  << " | " << std::setw(12) << pool_check << " | " << std::setw(12)
+                  << textbook_request << " | " << std::setw(12) << pool_request << " | "
+                  << std::setw(7) << pool_granted << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,112 @@
+// bench/event_bench.cpp
+// Discrete-event core. Part one is the classic hold model: with n events
+// pending, pop the earliest and push one a random exponential step later,
+// comparing CalendarQueue against a binary heap. Part two replays process
+// lifecycles through WorkloadSimulation with each scheduler policy.
+//
+// Usage: event_bench [processes]
+#include "sim/calendar_queue.hpp"
+#include "sim/workload_simulation.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <vector>
+
+using namespace os_sim;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr size_t kPendingCounts[] = {100, 10000, 1000000};
+constexpr size_t kHoldOperations = 5000000;
+
+struct Later {
+    bool operator()(const Event& lhs, const Event& rhs) const { return runsBefore(rhs, lhs); }
+};
+
+class HeapQueue {
+public:
+    void push(const Event& event) { heap_.push(event); }
+    Event pop() {
+        Event event = heap_.top();
+        heap_.pop();
+        return event;
+    }
+
+private:
+    std::priority_queue<Event, std::vector<Event>, Later> heap_;
+};
+
+// Nanoseconds per hold operation (one pop plus one push)
+template<class Queue>
+double holdCost(size_t pending) {
+    Queue queue;
+    std::mt19937_64 random(42);
+    // Mean step of 1 ms, the scale WorkloadSimulation works at
+    std::exponential_distribution<double> step(1.0 / 1e6);
+    uint64_t sequence = 0;
+
+    for (size_t i = 0; i < pending; ++i) {
+        Event event;
+        event.time = static_cast<SimTime>(step(random));
+        event.sequence = sequence++;
+        queue.push(event);
+    }
+
+    auto start = Clock::now();
+    for (size_t i = 0; i < kHoldOperations; ++i) {
+        Event event = queue.pop();
+        event.time += 1 + static_cast<SimTime>(step(random));
+        event.sequence = sequence++;
+        queue.push(event);
+    }
+    std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+    return elapsed.count() / kHoldOperations;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t processes = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    std::cout << std::fixed << std::setprecision(1);
+
+    std::cout << "Hold model (ns per pop+push)\n";
+    std::cout << std::setw(9) << "Pending" << " | "
+              << std::setw(14) << "binary heap" << " | "
+              << std::setw(14) << "CalendarQueue" << "\n";
+    std::cout << std::string(43, '-') << "\n";
+    for (size_t pending : kPendingCounts) {
+        std::cout << std::setw(9) << pending << " | "
+                  << std::setw(14) << holdCost<HeapQueue>(pending) << " | "
+                  << std::setw(14) << holdCost<CalendarQueue>(pending) << "\n";
+    }
+
+    std::cout << "\nWorkloadSimulation, " << processes << " processes on 4 CPUs\n";
+    std::cout << std::setw(9) << "Policy" << " | "
+              << std::setw(10) << "Events" << " | "
+              << std::setw(8) << "Wall s" << " | "
+              << std::setw(10) << "Mevents/s" << " | "
+              << std::setw(12) << "Virtual s" << " | "
+              << std::setw(14) << "Turnaround ms" << "\n";
+    std::cout << std::string(78, '-') << "\n";
+    for (const auto& policy : schedulerPolicyNames()) {
+        SimulationConfig config;
+        config.processes = processes;
+        config.cpus = 4;
+        config.policy = policy;
+        config.mean_interarrival = config.mean_interarrival / 4;
+
+        SimulationResult result = WorkloadSimulation(config).run();
+        std::cout << std::setw(9) << policy << " | "
+                  << std::setw(10) << result.events << " | "
+                  << std::setw(8) << result.wall_seconds << " | "
+                  << std::setw(10) << result.events / result.wall_seconds / 1e6 << " | "
+                  << std::setw(12) << result.end_time / 1e9 << " | "
+                  << std::setw(14) << result.mean_turnaround_ms << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,228 @@
+// bench/process_state_bench.cpp
+// Process state machine hot path. Compares Process against LockedProcess,
+// a copy of its previous design in which getState, getPriority and every
+// transition take the process mutex, transitions are checked with a switch
+// and each one notifies the condition variable. Single thread: reads,
+// READY <-> RUNNING transitions, and compareAndSetState from the wrong
+// state (the scheduler's retried picks and the balancer's probes). Mixed:
+// reader threads poll getState on a set of processes while one thread
+// moves them back and forth.
+//
+// Usage: process_state_bench [operations]
+#include "process/process.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace os_sim;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr size_t kReaderCounts[] = {1, 2, 4};
+constexpr size_t kMixedProcesses = 64;
+
+class LockedProcess {
+public:
+    LockedProcess(ProcessID pid, std::string name, Priority priority)
+        : pid_(pid), priority_(priority), name_(std::move(name)) {}
+
+    ProcessID getPID() const { return pid_; }
+
+    ProcessState getState() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return state_;
+    }
+
+    Priority getPriority() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return priority_;
+    }
+
+    void setState(ProcessState new_state) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (canTransitionTo(new_state)) {
+            applyState(new_state);
+        }
+    }
+
+    bool compareAndSetState(ProcessState expected, ProcessState desired) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (state_ != expected || !canTransitionTo(desired)) {
+            return false;
+        }
+        applyState(desired);
+        return true;
+    }
+
+private:
+    void applyState(ProcessState new_state) {
+        state_ = new_state;
+        stats_.context_switches++;
+        if (state_ == ProcessState::RUNNING) {
+            auto now = Clock::now();
+            stats_.cpu_time +=
+                std::chrono::duration_cast<std::chrono::milliseconds>(now - last_update_).count();
+            last_update_ = now;
+        }
+        cv_.notify_all();
+    }
+
+    bool canTransitionTo(ProcessState new_state) const {
+        switch (state_) {
+            case ProcessState::NEW:
+                return new_state == ProcessState::READY;
+            case ProcessState::READY:
+                return new_state == ProcessState::RUNNING ||
+                       new_state == ProcessState::WAITING ||
+                       new_state == ProcessState::TERMINATED;
+            case ProcessState::RUNNING:
+                return new_state == ProcessState::READY ||
+                       new_state == ProcessState::WAITING ||
+                       new_state == ProcessState::TERMINATED;
+            case ProcessState::WAITING:
+                return new_state == ProcessState::READY ||
+                       new_state == ProcessState::TERMINATED;
+            default:
+                return false;
+        }
+    }
+
+    mutable std::mutex mutex_;
+    ProcessID pid_;
+    ProcessState state_{ProcessState::NEW};
+    Priority priority_;
+    Clock::time_point last_update_{Clock::now()};
+    std::condition_variable cv_;
+    std::string name_;
+    ProcessStats stats_;
+};
+
+template<class P>
+std::vector<std::unique_ptr<P>> makeReady(size_t count) {
+    std::vector<std::unique_ptr<P>> processes;
+    for (size_t i = 0; i < count; ++i) {
+        processes.push_back(std::make_unique<P>(static_cast<ProcessID>(i), "bench", 0));
+        processes.back()->setState(ProcessState::READY);
+    }
+    return processes;
+}
+
+template<class Operation>
+double nsPerOperation(size_t operations, Operation&& operation) {
+    auto start = Clock::now();
+    for (size_t i = 0; i < operations; ++i) {
+        operation(i);
+    }
+    std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+    return elapsed.count() / operations;
+}
+
+// Nanoseconds per getState, getPriority, transition and refused transition
+template<class P>
+std::vector<double> singleThread(size_t operations) {
+    auto process = std::move(makeReady<P>(1)[0]);
+    // Keeps the reads from being optimized out without adding an atomic
+    volatile size_t sink = 0;
+    std::vector<double> costs;
+
+    costs.push_back(nsPerOperation(operations, [&](size_t) {
+        sink = sink + static_cast<size_t>(process->getState());
+    }));
+    costs.push_back(nsPerOperation(operations, [&](size_t) {
+        sink = sink + static_cast<size_t>(process->getPriority());
+    }));
+    costs.push_back(nsPerOperation(operations, [&](size_t i) {
+        if (i % 2 == 0) {
+            process->compareAndSetState(ProcessState::READY, ProcessState::RUNNING);
+        } else {
+            process->compareAndSetState(ProcessState::RUNNING, ProcessState::READY);
+        }
+    }));
+    costs.push_back(nsPerOperation(operations, [&](size_t) {
+        sink = sink + process->compareAndSetState(ProcessState::WAITING, ProcessState::RUNNING);
+    }));
+    return costs;
+}
+
+// Million getState calls per second across readers, with one thread
+// switching the same processes between READY and RUNNING throughout
+template<class P>
+double mixedThroughput(size_t operations, size_t readers) {
+    auto processes = makeReady<P>(kMixedProcesses);
+    std::atomic<bool> go{false};
+    std::atomic<bool> done{false};
+
+    std::thread writer([&] {
+        while (!go) std::this_thread::yield();
+        for (size_t i = 0; !done; ++i) {
+            auto& process = processes[i % kMixedProcesses];
+            if (!process->compareAndSetState(ProcessState::READY, ProcessState::RUNNING)) {
+                process->compareAndSetState(ProcessState::RUNNING, ProcessState::READY);
+            }
+        }
+    });
+
+    std::atomic<size_t> sink{0};
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < readers; ++t) {
+        workers.emplace_back([&, t] {
+            size_t running = 0;
+            while (!go) std::this_thread::yield();
+            for (size_t i = 0; i < operations; ++i) {
+                running += processes[(i + t) % kMixedProcesses]->getState() ==
+                           ProcessState::RUNNING;
+            }
+            sink += running;
+        });
+    }
+
+    auto start = Clock::now();
+    go = true;
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+    done = true;
+    writer.join();
+    return readers * operations / elapsed.count() / 1e6;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t operations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+    std::cout << std::fixed << std::setprecision(2);
+
+    std::cout << "Single thread (ns per call)\n";
+    std::cout << std::setw(22) << "" << " | " << std::setw(8) << "locked" << " | "
+              << std::setw(8) << "atomic" << "\n";
+    std::cout << std::string(44, '-') << "\n";
+    auto locked = singleThread<LockedProcess>(operations);
+    auto atomic = singleThread<Process>(operations);
+    const char* names[] = {"getState", "getPriority", "transition", "refused transition"};
+    for (size_t i = 0; i < locked.size(); ++i) {
+        std::cout << std::setw(22) << names[i] << " | " << std::setw(8) << locked[i] << " | "
+                  << std::setw(8) << atomic[i] << "\n";
+    }
+
+    std::cout << "\ngetState during transitions (M calls/s)\n";
+    std::cout << std::setw(7) << "Readers" << " | " << std::setw(8) << "locked" << " | "
+              << std::setw(8) << "atomic" << "\n";
+    std::cout << std::string(29, '-') << "\n";
+    for (size_t readers : kReaderCounts) {
+        double locked_rate = mixedThroughput<LockedProcess>(operations, readers);
+        double atomic_rate = mixedThroughput<Process>(operations, readers);
+        std::cout << std::setw(7) << readers << " | " << std::setw(8) << locked_rate << " | "
+                  << std::setw(8) << atomic_rate << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,214 @@
+// bench/process_table_bench.cpp
+// Process table contention. Lookups: every thread calls getProcess on
+// random pids of a pre-populated table, comparing ProcessManager's paged
+// pid-indexed table against a single-mutex map. Creates: every thread
+// creates processes through ProcessManager, then terminates them. Batches:
+// createProcesses/terminateProcesses against the same number of single
+// calls. Sweeps: full-table passes of listProcesses and getSnapshot, next
+// to getSystemStats, which reads running totals instead of the table.
+//
+// Usage: process_table_bench [table_size]
+#include "process/process_manager.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace os_sim;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr size_t kThreadCounts[] = {1, 2, 4, 8, 16};
+constexpr size_t kLookupsPerThread = 1000000;
+constexpr size_t kCreatesPerThread = 20000;
+constexpr size_t kSweeps = 20;
+constexpr size_t kBatchSize = 50000;
+
+// One mutex around one map
+class GlobalTable {
+public:
+    void insert(ProcessID pid, std::shared_ptr<Process> process) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        processes_[pid] = std::move(process);
+    }
+
+    std::shared_ptr<Process> getProcess(ProcessID pid) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = processes_.find(pid);
+        return (it != processes_.end()) ? it->second : nullptr;
+    }
+
+private:
+    std::mutex mutex_;
+    std::unordered_map<ProcessID, std::shared_ptr<Process>> processes_;
+};
+
+// Million lookups per second across all threads
+template<class Table>
+double lookupThroughput(Table& table, const std::vector<ProcessID>& pids, size_t threads) {
+    std::atomic<bool> go{false};
+    std::atomic<size_t> found{0};
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            std::mt19937 random(static_cast<uint32_t>(t + 1));
+            size_t hits = 0;
+            while (!go) std::this_thread::yield();
+            for (size_t i = 0; i < kLookupsPerThread; ++i) {
+                hits += table.getProcess(pids[random() % pids.size()]) != nullptr;
+            }
+            found += hits;
+        });
+    }
+
+    auto start = Clock::now();
+    go = true;
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+    return threads * kLookupsPerThread / elapsed.count() / 1e6;
+}
+
+// Thousand creates per second across all threads
+double createThroughput(size_t threads) {
+    auto& pm = ProcessManager::getInstance();
+    std::atomic<bool> go{false};
+    std::vector<std::vector<ProcessID>> created(threads);
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            created[t].reserve(kCreatesPerThread);
+            while (!go) std::this_thread::yield();
+            for (size_t i = 0; i < kCreatesPerThread; ++i) {
+                created[t].push_back(pm.createProcess("bench")->getPID());
+            }
+        });
+    }
+
+    auto start = Clock::now();
+    go = true;
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+
+    for (const auto& pids : created) {
+        for (ProcessID pid : pids) {
+            pm.terminateProcess(pid);
+        }
+    }
+    return threads * kCreatesPerThread / elapsed.count() / 1e3;
+}
+
+// Nanoseconds per process to create and then terminate kBatchSize processes
+std::pair<double, double> batchCost(bool batched) {
+    auto& pm = ProcessManager::getInstance();
+    std::vector<ProcessID> pids;
+    pids.reserve(kBatchSize);
+
+    auto start = Clock::now();
+    if (batched) {
+        std::vector<ProcessSpec> specs(kBatchSize, {"bench", 0});
+        for (const auto& process : pm.createProcesses(specs)) {
+            pids.push_back(process->getPID());
+        }
+    } else {
+        for (size_t i = 0; i < kBatchSize; ++i) {
+            pids.push_back(pm.createProcess("bench")->getPID());
+        }
+    }
+    auto created = Clock::now();
+    if (batched) {
+        pm.terminateProcesses(pids);
+    } else {
+        for (ProcessID pid : pids) {
+            pm.terminateProcess(pid);
+        }
+    }
+    auto terminated = Clock::now();
+
+    std::chrono::duration<double, std::nano> create = created - start;
+    std::chrono::duration<double, std::nano> terminate = terminated - created;
+    return {create.count() / kBatchSize, terminate.count() / kBatchSize};
+}
+
+// Nanoseconds per process for one full-table pass
+template<class Sweep>
+double sweepCost(size_t table_size, Sweep&& sweep) {
+    auto start = Clock::now();
+    for (size_t i = 0; i < kSweeps; ++i) {
+        sweep();
+    }
+    std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+    return elapsed.count() / kSweeps / table_size;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t table_size = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+    std::cout << std::fixed << std::setprecision(2);
+
+    auto& pm = ProcessManager::getInstance();
+    GlobalTable global;
+    std::vector<ProcessID> pids;
+    pids.reserve(table_size);
+    for (size_t i = 0; i < table_size; ++i) {
+        auto process = pm.createProcess("bench");
+        global.insert(process->getPID(), process);
+        pids.push_back(process->getPID());
+    }
+    std::cout << "Table size: " << pm.getProcessCount()
+              << ", sizeof(Process): " << sizeof(Process) << " bytes\n";
+
+    std::cout << "\ngetProcess (Mops/s)\n";
+    std::cout << std::setw(7) << "Threads" << " | "
+              << std::setw(12) << "global mutex" << " | "
+              << std::setw(12) << "paged" << "\n";
+    std::cout << std::string(37, '-') << "\n";
+    for (size_t threads : kThreadCounts) {
+        double locked = lookupThroughput(global, pids, threads);
+        double paged = lookupThroughput(pm, pids, threads);
+        std::cout << std::setw(7) << threads << " | "
+                  << std::setw(12) << locked << " | "
+                  << std::setw(12) << paged << "\n";
+    }
+
+    std::cout << "\nSweeps (ns per process)\n";
+    std::cout << "  listProcesses:  "
+              << sweepCost(table_size, [&pm] { return pm.listProcesses().size(); }) << "\n";
+    std::cout << "  getSnapshot:    "
+              << sweepCost(table_size, [&pm] { return pm.getSnapshot()->size(); }) << "\n";
+    std::cout << "  getSystemStats: "
+              << sweepCost(table_size, [&pm] { return pm.getSystemStats().cpu_time; })
+              << " (" << sweepCost(1, [&pm] { return pm.getSystemStats().cpu_time; })
+              << " ns per call)\n";
+
+    std::cout << "\n" << kBatchSize << " processes (ns per process)\n";
+    std::cout << std::setw(7) << "" << " | " << std::setw(10) << "create" << " | "
+              << std::setw(10) << "terminate" << "\n";
+    std::cout << std::string(35, '-') << "\n";
+    for (bool batched : {false, true}) {
+        auto [create, terminate] = batchCost(batched);
+        std::cout << std::setw(7) << (batched ? "batch" : "single") << " | "
+                  << std::setw(10) << create << " | " << std::setw(10) << terminate << "\n";
+    }
+
+    std::cout << "\ncreateProcess (Kops/s)\n";
+    std::cout << std::setw(7) << "Threads" << " | " << std::setw(12) << "paged" << "\n";
+    std::cout << std::string(22, '-') << "\n";
+    for (size_t threads : kThreadCounts) {
+        std::cout << std::setw(7) << threads << " | "
+                  << std::setw(12) << createThroughput(threads) << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,184 @@
+// bench/queue_bench.cpp
+// Producer contention on the pool's global queue. Part one compares the
+// bare queues: MpmcQueue against a mutex-protected std::queue, with a fixed
+// set of consumers. Part two runs the same load through ThreadPool in
+// SHARED_QUEUE and BOUNDED_QUEUE mode (default queue_capacity).
+//
+// Usage: queue_bench [items_per_run]
+#include "thread/mpmc_queue.hpp"
+#include "thread/thread_pool.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+using namespace os_sim;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr size_t kConsumers = 4;
+constexpr size_t kProducerCounts[] = {1, 2, 4, 8, 16, 32, 64};
+
+// The shape of the original ThreadPool queue
+class MutexQueue {
+public:
+    bool tryPush(uintptr_t value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push(value);
+        return true;
+    }
+
+    bool tryPop(uintptr_t& value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (queue_.empty()) {
+            return false;
+        }
+        value = queue_.front();
+        queue_.pop();
+        return true;
+    }
+
+private:
+    std::mutex mutex_;
+    std::queue<uintptr_t> queue_;
+};
+
+template<class Queue>
+double queueThroughput(Queue& queue, size_t producers, size_t items) {
+    size_t per_producer = items / producers;
+    size_t total = per_producer * producers;
+    std::atomic<size_t> consumed{0};
+    std::atomic<bool> go{false};
+
+    std::vector<std::thread> threads;
+    for (size_t p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p] {
+            while (!go) std::this_thread::yield();
+            for (size_t i = 0; i < per_producer; ++i) {
+                while (!queue.tryPush(p * per_producer + i + 1)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (size_t c = 0; c < kConsumers; ++c) {
+        threads.emplace_back([&] {
+            while (!go) std::this_thread::yield();
+            uintptr_t value = 0;
+            while (consumed.load(std::memory_order_relaxed) < total) {
+                if (queue.tryPop(value)) {
+                    consumed.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    auto start = Clock::now();
+    go = true;
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+    return total / elapsed.count() / 1e6;
+}
+
+struct PoolResult {
+    double throughput;      // Mops/s
+    double wait_p99;        // microseconds
+};
+
+PoolResult poolThroughput(ThreadPoolMode mode, size_t producers, size_t items) {
+    ThreadPoolConfig config;
+    config.mode = mode;
+    config.min_threads = kConsumers;
+    config.max_threads = kConsumers;
+    ThreadPool pool(config);
+
+    size_t per_producer = items / producers;
+    size_t total = per_producer * producers;
+    std::atomic<size_t> done{0};
+    std::atomic<bool> go{false};
+
+    std::vector<std::thread> threads;
+    for (size_t p = 0; p < producers; ++p) {
+        threads.emplace_back([&] {
+            while (!go) std::this_thread::yield();
+            for (size_t i = 0; i < per_producer; ++i) {
+                pool.post([&done] { done.fetch_add(1, std::memory_order_relaxed); });
+            }
+        });
+    }
+
+    auto start = Clock::now();
+    go = true;
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    while (done.load() < total) {
+        std::this_thread::yield();
+    }
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+    return PoolResult{total / elapsed.count() / 1e6,
+                      pool.getMetrics().queue_wait.p99 / 1000.0};
+}
+
+void printHeader(const char* title, const char* left, const char* right) {
+    std::cout << "\n" << title << " (Mops/s, " << kConsumers << " consumers)\n";
+    std::cout << std::setw(9) << "Producers" << " | "
+              << std::setw(14) << left << " | "
+              << std::setw(14) << right << "\n";
+    std::cout << std::string(43, '-') << "\n";
+}
+
+void printRow(size_t producers, double left, double right) {
+    std::cout << std::setw(9) << producers << " | "
+              << std::setw(14) << left << " | "
+              << std::setw(14) << right << "\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t items = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Items per run: " << items << "\n";
+
+    printHeader("Bare queue", "mutex queue", "MpmcQueue");
+    for (size_t producers : kProducerCounts) {
+        MutexQueue mutex_queue;
+        MpmcQueue<uintptr_t> ring(1024);
+        double locked = queueThroughput(mutex_queue, producers, items);
+        double lock_free = queueThroughput(ring, producers, items);
+        printRow(producers, locked, lock_free);
+    }
+
+    // Backpressure trades some producer throughput for a bounded backlog,
+    // which shows up as queue wait
+    std::cout << "\nThreadPool::post (Mops/s and p99 queue wait in us, "
+              << kConsumers << " workers)\n";
+    std::cout << std::setw(9) << "Producers" << " | "
+              << std::setw(14) << "SHARED_QUEUE" << " | "
+              << std::setw(10) << "p99 wait" << " | "
+              << std::setw(14) << "BOUNDED_QUEUE" << " | "
+              << std::setw(10) << "p99 wait" << "\n";
+    std::cout << std::string(69, '-') << "\n";
+    for (size_t producers : kProducerCounts) {
+        PoolResult shared = poolThroughput(ThreadPoolMode::SHARED_QUEUE, producers, items);
+        PoolResult bounded = poolThroughput(ThreadPoolMode::BOUNDED_QUEUE, producers, items);
+        std::cout << std::setw(9) << producers << " | "
+                  << std::setw(14) << shared.throughput << " | "
+                  << std::setw(10) << shared.wait_p99 << " | "
+                  << std::setw(14) << bounded.throughput << " | "
+                  << std::setw(10) << bounded.wait_p99 << "\n";
+    }
+
+    return 0;
+}
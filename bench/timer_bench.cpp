@@ -0,0 +1,152 @@
+// bench/timer_bench.cpp
+// Compares TimerWheel against a binary-heap timer queue on the operations a
+// simulator timer service performs: bulk insert, cancel of a fraction of the
+// timers, and draining everything through advance().
+//
+// Usage: timer_bench [timer_count]
+#include "thread/timer_wheel.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+using namespace os_sim;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+// Typical heap-based timer: cancel marks an id and the entry is skipped
+// when it reaches the top, since a binary heap cannot remove in the middle.
+class HeapTimerQueue {
+public:
+    uint64_t schedule(Clock::time_point when, Task task) {
+        uint64_t id = next_id_++;
+        heap_.push(Entry{when, id});
+        tasks_.push_back(std::move(task));
+        return id;
+    }
+
+    bool cancel(uint64_t id) {
+        return cancelled_.insert(id).second;
+    }
+
+    size_t advance(Clock::time_point now) {
+        size_t fired = 0;
+        while (!heap_.empty() && heap_.top().when <= now) {
+            uint64_t id = heap_.top().id;
+            heap_.pop();
+            if (cancelled_.erase(id)) {
+                continue;
+            }
+            tasks_[id]();
+            tasks_[id].reset();
+            ++fired;
+        }
+        return fired;
+    }
+
+private:
+    struct Entry {
+        Clock::time_point when;
+        uint64_t id;
+        bool operator>(const Entry& other) const { return when > other.when; }
+    };
+
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap_;
+    std::vector<Task> tasks_;
+    std::unordered_set<uint64_t> cancelled_;
+    uint64_t next_id_ = 0;
+};
+
+struct Result {
+    double insert_ns;
+    double cancel_ns;
+    double drain_ms;
+    size_t fired;
+};
+
+template<class Queue>
+Result run(size_t count, const std::vector<uint32_t>& delays_ms, Clock::time_point origin) {
+    Queue queue = [origin] {
+        if constexpr (std::is_same<Queue, TimerWheel>::value) {
+            return TimerWheel(std::chrono::milliseconds(1), origin);
+        } else {
+            return Queue();
+        }
+    }();
+
+    uint64_t sink = 0;
+    std::vector<uint64_t> ids(count);
+
+    auto start = Clock::now();
+    for (size_t i = 0; i < count; ++i) {
+        ids[i] = queue.schedule(origin + std::chrono::milliseconds(delays_ms[i]),
+                                [&sink, i] { sink += i; });
+    }
+    auto inserted = Clock::now();
+
+    // Cancel every fourth timer, like leases released before they expire
+    size_t cancelled = 0;
+    for (size_t i = 0; i < count; i += 4) {
+        cancelled += queue.cancel(ids[i]);
+    }
+    auto cancelled_at = Clock::now();
+
+    // Drain in 1 ms steps of simulated time
+    size_t fired = 0;
+    for (uint32_t ms = 0; ms <= 60000; ++ms) {
+        fired += queue.advance(origin + std::chrono::milliseconds(ms));
+    }
+    auto drained = Clock::now();
+
+    if (sink == 1) {
+        std::cout << "";  // Keep the callbacks observable
+    }
+
+    using ns = std::chrono::duration<double, std::nano>;
+    using ms = std::chrono::duration<double, std::milli>;
+    return Result{
+        ns(inserted - start).count() / count,
+        ns(cancelled_at - inserted).count() / std::max<size_t>(cancelled, 1),
+        ms(drained - cancelled_at).count(),
+        fired,
+    };
+}
+
+void print(const char* name, const Result& result) {
+    std::cout << std::setw(12) << name << " | "
+              << std::setw(10) << std::fixed << std::setprecision(1) << result.insert_ns << " | "
+              << std::setw(10) << result.cancel_ns << " | "
+              << std::setw(10) << result.drain_ms << " | "
+              << std::setw(9) << result.fired << "\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+    // Delays up to one minute, skewed towards short quanta
+    std::mt19937 rng(42);
+    std::vector<uint32_t> delays(count);
+    for (auto& delay : delays) {
+        delay = (rng() % 4 == 0) ? 1 + rng() % 60000 : 1 + rng() % 100;
+    }
+
+    auto origin = Clock::now();
+    std::cout << "Timers: " << count << "\n";
+    std::cout << std::setw(12) << "Queue" << " | "
+              << std::setw(10) << "Insert ns" << " | "
+              << std::setw(10) << "Cancel ns" << " | "
+              << std::setw(10) << "Drain ms" << " | "
+              << std::setw(9) << "Fired" << "\n";
+    std::cout << std::string(62, '-') << "\n";
+    print("TimerWheel", run<TimerWheel>(count, delays, origin));
+    print("Heap", run<HeapTimerQueue>(count, delays, origin));
+
+    return 0;
+}
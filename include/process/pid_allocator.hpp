@@ -0,0 +1,60 @@
+// include/process/pid_allocator.hpp
+#pragma once
+#include "types.hpp"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace os_sim {
+
+// Hands out pids from [0, limit), lowest free first, so pid-indexed arrays
+// stay as small as the live process count allows. Free pids are tracked in
+// a 64-ary bitmap tree: a leaf bit is a free pid, an inner bit says its
+// child word may have free bits. allocate and free touch one word per
+// level, all with atomic operations and no locks.
+//
+// A freed pid is parked for reuse_delay further frees before it can be
+// handed out again, so a pid kept by mistake after its process is gone
+// does not immediately name a new process.
+class PidAllocator {
+public:
+    static constexpr ProcessID kDefaultLimit = 1 << 22;
+    static constexpr size_t kDefaultReuseDelay = 1024;
+
+    explicit PidAllocator(ProcessID limit = kDefaultLimit,
+                          size_t reuse_delay = kDefaultReuseDelay);
+
+    // -1 when every pid is in use or still waiting out its reuse delay
+    ProcessID allocate();
+    // Appends count pids, taking up to a word's worth per atomic exchange;
+    // all or nothing, false (and pids unchanged) if there are not enough
+    bool allocate(size_t count, std::vector<ProcessID>& pids);
+    // pid must have come from allocate() and not been freed since
+    void free(ProcessID pid);
+
+    ProcessID limit() const { return limit_; }
+    // Allocated and not yet freed
+    size_t inUse() const { return in_use_.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr size_t kWordBits = 64;
+    using Level = std::unique_ptr<std::atomic<uint64_t>[]>;
+
+    size_t claim(size_t level, size_t index, ProcessID* out, size_t count);
+    void release(ProcessID pid);
+    void markFull(size_t level, size_t child);
+    void markFree(size_t level, size_t child);
+
+    ProcessID limit_;
+    // levels_[0] holds the leaves, levels_.back() is a single word
+    std::vector<Level> levels_;
+
+    // Ring of freed pids waiting to be released, -1 for an empty slot
+    size_t reuse_delay_;
+    std::unique_ptr<std::atomic<ProcessID>[]> delayed_;
+    std::atomic<uint64_t> delayed_cursor_{0};
+    std::atomic<size_t> in_use_{0};
+};
+
+} // namespace os_sim
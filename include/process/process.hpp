@@ -1,32 +1,79 @@
 // include/process/process.hpp
 #pragma once
+#include "process/process_snapshot.hpp"
 #include "types.hpp"
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <condition_variable>
+#include <string>
 #include <vector>
-#include <queue>
 
 namespace os_sim {
 
+// Told about every state, priority, CPU, stats and resource change while
+// the process mutex is held, so observers see changes in order. All but
+// migrations are reported after the fact; a migration is reported before
+// it happens and is cancelled if onMigrated returns false. Implementations
+// must not call back into the process.
+class ProcessObserver {
+public:
+    virtual ~ProcessObserver() = default;
+    virtual void onStateChanged(ProcessID pid, Priority priority, size_t cpu,
+                                ProcessState old_state, ProcessState new_state) = 0;
+    virtual void onPriorityChanged(ProcessID pid, ProcessState state, size_t cpu,
+                                   Priority old_priority, Priority new_priority) = 0;
+    virtual bool onMigrated(ProcessID pid, Priority priority,
+                            size_t from_cpu, size_t to_cpu) = 0;
+    virtual void onStatsChanged(ProcessID pid, size_t cpu,
+                                const ProcessStats& old_stats, const ProcessStats& new_stats) = 0;
+    virtual void onResourceChanged(ProcessID pid, ResourceID resource, bool allocated) = 0;
+};
+
 class Process {
 public:
     Process(ProcessID pid, std::string name, Priority priority = 0);
     ~Process();  // Remove the = default
 
-    // Basic getters
+    // Basic getters; state and priority are read without the lock
     ProcessID getPID() const { return pid_; }
-    ProcessState getState() const;
-    Priority getPriority() const;
+    ProcessState getState() const { return state_.load(std::memory_order_acquire); }
+    Priority getPriority() const { return priority_.load(std::memory_order_acquire); }
     const std::string& getName() const { return name_; }
-    const ProcessStats& getStats() const { return stats_; }
+    ProcessStats getStats() const;
+    // Appends this process as one row, read under a single lock
+    void appendTo(ProcessSnapshot& snapshot) const;
 
-    // State management
+    // State management. Transitions are checked against a constant table
+    // and still made under the lock, so observers see them in order; a
+    // compareAndSetState that cannot succeed returns without locking.
     void setState(ProcessState new_state);
+    // Moves to desired only if currently in expected; false otherwise
+    bool compareAndSetState(ProcessState expected, ProcessState desired);
     void setPriority(Priority new_priority);
+    // Blocks until the process is in state; false if timeout passes first
+    bool waitForState(ProcessState state, std::chrono::milliseconds timeout);
 
-    // Resource management
+    // At most one observer; set before the process is shared
+    void setObserver(ProcessObserver* observer) { observer_ = observer; }
+    // Stops reporting and returns the stats as of the last report, in one
+    // step, so the observer can take back exactly what it was told
+    ProcessStats detachObserver();
+
+    // Simulated CPU whose run queue holds the process. Set the initial CPU
+    // before the process is shared; migrate() moves only READY processes
+    // and fails if the process is no longer READY on from_cpu.
+    size_t getCpu() const;
+    void setCpu(size_t cpu) { cpu_ = cpu; }
+    bool migrate(size_t from_cpu, size_t to_cpu);
+
+    // Resource management. acquireResource waits for a held resource
+    // (see ResourceManager::acquireResource), parked in WAITING meanwhile if
+    // it was READY or RUNNING; terminating the process ends the wait.
     ErrorCode requestResource(ResourceID resource_id);
+    ErrorCode acquireResource(ResourceID resource_id,
+                              std::chrono::milliseconds timeout = std::chrono::milliseconds::max());
     ErrorCode releaseResource(ResourceID resource_id);
     bool hasResource(ResourceID resource_id) const;
     std::vector<ResourceID> getAllocatedResources() const;
@@ -37,21 +84,33 @@ public:
     void terminate();
 
 private:
+    // Scheduling fields first, next to the lock that guards them; names,
+    // resources and stats are only read by monitoring. state_ and
+    // priority_ are written under the lock but read without it.
+    mutable std::mutex process_mutex_;
     ProcessID pid_;
+    std::atomic<ProcessState> state_;
+    std::atomic<Priority> priority_;
+    size_t cpu_{0};
+    ProcessObserver* observer_{nullptr};
+    // CycleClock reading when the current state was entered
+    uint64_t state_since_;
+    // Transitions notify state_cv_ only while waiters_ is non-zero
+    std::condition_variable state_cv_;
+    size_t waiters_{0};
+
     std::string name_;
-    ProcessState state_;
-    Priority priority_;
     ProcessStats stats_;
-
     std::vector<ResourceID> allocated_resources_;
-    std::queue<std::string> message_queue_;
-
-    mutable std::mutex process_mutex_;
-    std::condition_variable state_cv_;
+    // Resource acquireResource is blocked on, -1 if none
+    ResourceID pending_resource_{-1};
 
     // Internal helper methods
+    void applyState(ProcessState old_state, ProcessState new_state);
+    void chargeState(ProcessState state);
+    void addResource(ResourceID resource_id);
     void updateStats();
-    bool canTransitionTo(ProcessState new_state) const;
+    void reportStats(const ProcessStats& old_stats);
 };
 
 } // namespace os_sim
\ No newline at end of file
@@ -0,0 +1,115 @@
+// include/process/process_event_bus.hpp
+#pragma once
+#include "thread/mpmc_queue.hpp"
+#include "types.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace os_sim {
+
+using SubscriberID = int32_t;
+
+enum class ProcessEventType : uint8_t {
+    CREATED,             // new_state is the state it was published in
+    STATE_CHANGED,
+    TERMINATED,          // Gone from the process table, resources released
+    RESOURCE_ALLOCATED,
+    RESOURCE_RELEASED
+};
+
+constexpr size_t kProcessEventTypeCount = 5;
+
+constexpr uint32_t eventMask(ProcessEventType type) {
+    return uint32_t{1} << static_cast<uint32_t>(type);
+}
+
+constexpr uint32_t kAllProcessEvents = (uint32_t{1} << kProcessEventTypeCount) - 1;
+
+// Plain value so rings can store events inline. old_state is only set for
+// STATE_CHANGED, resource only for the resource events.
+struct ProcessEvent {
+    uint64_t time{0};    // CycleClock reading at publication
+    ProcessEventType type{ProcessEventType::STATE_CHANGED};
+    ProcessID pid{-1};
+    ProcessState old_state{ProcessState::NEW};
+    ProcessState new_state{ProcessState::NEW};
+    ResourceID resource{-1};
+};
+
+// Fans process events out to up to kMaxSubscribers subscribers, each with
+// its own bounded ring that it drains in batches with poll(). Publishing
+// takes no locks: with nobody subscribed to an event type it is a single
+// atomic load, otherwise one ring push per interested subscriber. A full
+// ring drops the event and counts it rather than slow the publisher down.
+//
+// Events from one process arrive in the order they happened; events from
+// different processes are only ordered by their timestamps.
+class ProcessEventBus {
+public:
+    static constexpr size_t kMaxSubscribers = 64;
+    static constexpr size_t kDefaultCapacity = 4096;
+
+    ProcessEventBus() = default;
+    ProcessEventBus(const ProcessEventBus&) = delete;
+    ProcessEventBus& operator=(const ProcessEventBus&) = delete;
+
+    // types is a mask of eventMask() bits; -1 once every slot is taken
+    SubscriberID subscribe(uint32_t types = kAllProcessEvents,
+                           size_t capacity = kDefaultCapacity);
+    // Waits for publishers still pushing to the subscriber's ring; its
+    // undelivered events are discarded
+    void unsubscribe(SubscriberID subscriber);
+
+    // Appends up to max pending events to out and returns how many. One
+    // thread per subscriber, and not concurrently with its unsubscribe.
+    size_t poll(SubscriberID subscriber, std::vector<ProcessEvent>& out,
+                size_t max = SIZE_MAX);
+    // Events lost to a full ring since subscribing
+    uint64_t dropped(SubscriberID subscriber) const;
+
+    bool hasSubscribers(ProcessEventType type) const {
+        return interested_[index(type)].load(std::memory_order_relaxed) != 0;
+    }
+    // Stamps event.time and delivers it to every subscriber of its type
+    void publish(ProcessEvent event);
+
+private:
+    struct alignas(64) Subscriber {
+        // Publishers between deciding to push and finishing the push
+        std::atomic<uint32_t> publishers{0};
+        // Value of generation_ when the slot was last subscribed
+        std::atomic<uint64_t> generation{0};
+        std::atomic<uint64_t> dropped{0};
+        std::unique_ptr<MpmcQueue<ProcessEvent>> ring;
+    };
+
+    static size_t index(ProcessEventType type) { return static_cast<size_t>(type); }
+    bool valid(SubscriberID subscriber) const;
+
+    // Per event type, one bit per subscriber that wants it
+    std::array<std::atomic<uint64_t>, kProcessEventTypeCount> interested_{};
+    // Bumped by every subscribe; publish() reads it before the mask
+    std::atomic<uint64_t> generation_{0};
+    std::array<Subscriber, kMaxSubscribers> subscribers_;
+
+    // subscribe() and unsubscribe() only
+    std::mutex subscribe_mutex_;
+    uint64_t used_{0};
+};
+
+inline const char* toString(ProcessEventType type) {
+    switch (type) {
+        case ProcessEventType::CREATED: return "CREATED";
+        case ProcessEventType::STATE_CHANGED: return "STATE_CHANGED";
+        case ProcessEventType::TERMINATED: return "TERMINATED";
+        case ProcessEventType::RESOURCE_ALLOCATED: return "RESOURCE_ALLOCATED";
+        case ProcessEventType::RESOURCE_RELEASED: return "RESOURCE_RELEASED";
+        default: return "UNKNOWN";
+    }
+}
+
+} // namespace os_sim
@@ -1,49 +1,201 @@
 // include/process/process_manager.hpp
 #pragma once
 #include "process/process.hpp"
+#include "process/process_event_bus.hpp"
+#include "process/pid_allocator.hpp"
+#include "process/process_table.hpp"
+#include "process/scheduler_policy.hpp"
 #include <unordered_map>
 #include <memory>
 #include <mutex>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
 
 namespace os_sim {
 
-class ProcessManager {
+class ThreadPool;
+
+// Outcome of ProcessManager::runScheduler()
+struct SchedulingReport {
+    size_t ticks{0};
+    size_t cpus{0};
+    size_t busy_ticks{0};        // CPU-ticks with a process running
+    size_t dispatches{0};        // CPU-ticks that put a different process on
+    size_t runnable{0};          // Processes ready or running during the run
+    size_t processes_run{0};     // Of those, how many got at least one tick
+    double fairness{1.0};        // Jain's index over ticks per runnable process
+    double ns_per_tick{0.0};     // Wall-clock scheduling cost
+};
+
+// One process of a createProcesses() batch
+struct ProcessSpec {
+    std::string name;
+    Priority priority{0};
+};
+
+class ProcessManager : private ProcessObserver {
 public:
     static ProcessManager& getInstance();
     
     // Process lifecycle management
+    // createProcess returns nullptr once every pid is taken. Terminating
+    // releases the process's resources and then its pid, which is handed
+    // out again only after PidAllocator's reuse delay.
     std::shared_ptr<Process> createProcess(const std::string& name, Priority priority = 0);
     ErrorCode terminateProcess(ProcessID pid);
+
+    // Batch forms. createProcesses reserves every pid up front and is all
+    // or nothing, returning an empty list if there are not enough. The
+    // processes are built and made READY before anything can see them, then
+    // published with one lock per CPU run queue and one per table page.
+    // terminateProcesses returns how many of pids it terminated.
+    std::vector<std::shared_ptr<Process>> createProcesses(const std::vector<ProcessSpec>& specs);
+    size_t terminateProcesses(const std::vector<ProcessID>& pids);
     
     // Process control
     ErrorCode suspendProcess(ProcessID pid);
     ErrorCode resumeProcess(ProcessID pid);
     
-    // Process scheduling
+    // Simulated CPUs, each with its own run queue and policy instance. Only
+    // while no processes exist and nothing is being created or scheduled;
+    // false otherwise or for zero.
+    bool setCpuCount(size_t count);
+    size_t getCpuCount() const { return cpus_.size(); }
+    std::vector<CpuStats> getCpuStats() const;
+
+    // One scheduling tick on every CPU
     void scheduleProcesses();
+    // One tick on a single CPU: charges its running process to the policy
+    // and, once the slice is used up, preempts it and starts the policy's
+    // pick. Takes only that CPU's lock (and briefly a peer's when balancing),
+    // so different CPUs can be ticked from different threads.
+    void scheduleCpu(size_t cpu);
+    SchedulingReport runScheduler(size_t ticks);
+    size_t getReadyCount() const;
+
+    // Switches policy by name (see schedulerPolicyNames()) on every CPU;
+    // READY processes are handed over to the new policy. False for an
+    // unknown name.
+    bool setSchedulerPolicy(const std::string& name);
+    std::string getSchedulerPolicy() const;
     
     // Process queries
     std::shared_ptr<Process> getProcess(ProcessID pid);
+    // A handle resolves only to the process it was taken from, nullptr once
+    // that process is gone even if its pid is given out again
+    ProcessHandle getHandle(ProcessID pid) const { return table_.handleOf(pid); }
+    std::shared_ptr<Process> getProcess(const ProcessHandle& handle);
     std::vector<ProcessID> listProcesses() const;
+    // Every process in one pass, one lock round trip per process, none of
+    // them on a lock the scheduler waits for. Callers that poll can accept
+    // a snapshot up to max_age old instead of building a new one; the last
+    // reader of a snapshot frees it.
+    std::shared_ptr<const ProcessSnapshot> getSnapshot(
+        std::chrono::steady_clock::duration max_age = std::chrono::steady_clock::duration::zero());
     
     // System statistics
-    size_t getProcessCount() const;
+    size_t getProcessCount() const { return table_.size(); }
+    ProcessID getPidLimit() const { return pids_.limit(); }
+    // Sum of the stats of every process in the table, kept up to date as
+    // they change rather than added up on each call: a read costs a few
+    // atomic loads per CPU. Each field is exact, but a read can fall
+    // between the updates of one change.
     ProcessStats getSystemStats() const;
 
+    // Pool used for table-wide sweeps; nullptr sweeps on the calling thread
+    void setThreadPool(ThreadPool* pool);
+
+    // Process lifecycle and resource events, published without locks from
+    // wherever they happen; subscribe instead of polling listProcesses
+    ProcessEventBus& getEventBus() { return events_; }
+
 private:
-    ProcessManager() = default;
+    ProcessManager();
     ~ProcessManager() = default;
     ProcessManager(const ProcessManager&) = delete;
     ProcessManager& operator=(const ProcessManager&) = delete;
 
-    std::unordered_map<ProcessID, std::shared_ptr<Process>> processes_;
-    ProcessID next_pid_{0};
-    mutable std::mutex manager_mutex_;
+    // Stats reported by the processes on one CPU, updated with relaxed
+    // atomics. A process is taken back out from whichever CPU it is on when
+    // it goes, so one CPU's totals may wrap; only their sum means anything.
+    struct StatsTotals {
+        std::atomic<uint64_t> cpu_time{0};
+        std::atomic<uint64_t> ready_time{0};
+        std::atomic<uint64_t> wait_time{0};
+        std::atomic<uint64_t> memory_used{0};
+        std::atomic<uint64_t> io_operations{0};
+        std::atomic<uint64_t> context_switches{0};
+    };
+
+    // A simulated CPU. members holds every live process homed here, so
+    // ticks never touch the process table; ready and running map pid to priority so
+    // a new policy can be seeded. The counters mirror ready/running for
+    // lock-free sampling by placement and balancing.
+    struct Cpu {
+        mutable std::mutex mutex;
+        std::unique_ptr<SchedulerPolicy> policy;
+        std::unordered_map<ProcessID, std::shared_ptr<Process>> members;
+        std::unordered_map<ProcessID, Priority> ready;
+        std::unordered_map<ProcessID, Priority> running;
+        std::atomic<size_t> ready_count{0};
+        std::atomic<size_t> running_count{0};
+        CpuStats stats;
+        // Own cache line: written by every stats change, without the mutex
+        alignas(64) StatsTotals totals;
+    };
+
+    // Declared first so it outlives every process that publishes to it
+    ProcessEventBus events_;
+
+    // Pids are table indices; lookups take only their page's lock, shared
+    ProcessTable table_;
+    PidAllocator pids_;
+
+    // Kept current by the ProcessObserver hooks. Lock order: a table page
+    // mutex, then a process mutex, then a CPU mutex; two CPU mutexes only
+    // together through std::scoped_lock. Fixed while processes exist.
+    std::vector<std::unique_ptr<Cpu>> cpus_;
+    std::atomic<ThreadPool*> thread_pool_{nullptr};
+
+    // Latest snapshot, read and replaced through std::atomic_load/store;
+    // the mutex only keeps two monitors from building at once
+    std::shared_ptr<const ProcessSnapshot> snapshot_;
+    std::mutex snapshot_mutex_;
+
+    // CPU ticks between periodic load balancing passes
+    static constexpr uint64_t kBalanceInterval = 8;
+    // Tables smaller than this are swept serially; parallel sweeps hand out
+    // this many table pages per chunk
+    static constexpr size_t kParallelSweepThreshold = 4096;
+    static constexpr size_t kSweepGrain = 8;
+
+    // ProcessObserver
+    void onStateChanged(ProcessID pid, Priority priority, size_t cpu,
+                        ProcessState old_state, ProcessState new_state) override;
+    void onPriorityChanged(ProcessID pid, ProcessState state, size_t cpu,
+                           Priority old_priority, Priority new_priority) override;
+    bool onMigrated(ProcessID pid, Priority priority,
+                    size_t from_cpu, size_t to_cpu) override;
+    void onStatsChanged(ProcessID pid, size_t cpu,
+                        const ProcessStats& old_stats, const ProcessStats& new_stats) override;
+    void onResourceChanged(ProcessID pid, ResourceID resource, bool allocated) override;
+
+    // Load balancing
+    size_t pickCpu() const;
+    void balanceCpu(size_t cpu);
+    bool pullIdle(size_t cpu);
+    size_t migrateReady(size_t from_cpu, size_t to_cpu, size_t count);
+    static void updateCounts(Cpu& cpu);
 
     // Helper methods
     ProcessID generateNextPID();
+    void retire(Process& process);
+    std::vector<std::shared_ptr<Process>> collectProcessesInState(ProcessState state) const;
     void cleanupTerminatedProcesses();
-    void updateSystemStats();
+    // Adds added and takes away removed from cpu's totals
+    void updateSystemStats(size_t cpu, const ProcessStats& added, const ProcessStats& removed);
 };
 
 } // namespace os_sim
\ No newline at end of file
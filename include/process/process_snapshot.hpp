@@ -0,0 +1,47 @@
+// include/process/process_snapshot.hpp
+#pragma once
+#include "types.hpp"
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace os_sim {
+
+// Copy of the process table for monitoring: one column per field, one row
+// per process in pid order. Each row is read under a single process lock,
+// so its fields agree with each other. Snapshots are never modified once
+// published and can be shared between readers without locks.
+struct ProcessSnapshot {
+    std::chrono::steady_clock::time_point taken_at;
+
+    std::vector<ProcessID> pids;
+    std::vector<std::string> names;
+    std::vector<Priority> priorities;
+    std::vector<ProcessState> states;
+    std::vector<size_t> cpus;
+    std::vector<ProcessStats> stats;
+    // Row i holds resources[resource_offsets[i], resource_offsets[i + 1])
+    std::vector<size_t> resource_offsets{0};
+    std::vector<ResourceID> resources;
+
+    size_t size() const { return pids.size(); }
+
+    // Row of pid, or size() if it has none
+    size_t find(ProcessID pid) const {
+        auto it = std::lower_bound(pids.begin(), pids.end(), pid);
+        return (it != pids.end() && *it == pid) ? static_cast<size_t>(it - pids.begin()) : size();
+    }
+
+    void reserve(size_t rows) {
+        pids.reserve(rows);
+        names.reserve(rows);
+        priorities.reserve(rows);
+        states.reserve(rows);
+        cpus.reserve(rows);
+        stats.reserve(rows);
+        resource_offsets.reserve(rows + 1);
+    }
+};
+
+} // namespace os_sim
@@ -0,0 +1,124 @@
+// include/process/process_table.hpp
+#pragma once
+#include "process/process.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <vector>
+
+namespace os_sim {
+
+// One incarnation of a pid. The table bumps a slot's generation each time
+// the slot is vacated, so a handle kept after its process is gone never
+// resolves to a later process that is given the same pid.
+struct ProcessHandle {
+    ProcessID pid{-1};
+    uint32_t generation{0};
+};
+
+// Dense pid-indexed process storage. Slots come in pages of kPageSize that
+// are allocated on first use and never move, each page with its own lock.
+// A page keeps every slot's generation and state in one word, apart from
+// the Process pointers, so sweeps filter on a few cache lines per page and
+// only touch the processes that match.
+class ProcessTable {
+public:
+    static constexpr size_t kPageSize = 64;
+
+    ProcessTable();
+    ~ProcessTable();
+    ProcessTable(const ProcessTable&) = delete;
+    ProcessTable& operator=(const ProcessTable&) = delete;
+
+    // False for a negative pid or an occupied slot
+    bool insert(const std::shared_ptr<Process>& process);
+    // Empties the slot; nullptr if it was empty or held another process
+    std::shared_ptr<Process> remove(ProcessID pid, const Process* expected = nullptr);
+    // Batch forms, taking each page's lock once per run of pids on that
+    // page. insert returns how many went in; remove skips empty slots.
+    size_t insert(const std::vector<std::shared_ptr<Process>>& processes);
+    std::vector<std::shared_ptr<Process>> remove(const std::vector<ProcessID>& pids);
+
+    std::shared_ptr<Process> find(ProcessID pid) const;
+    std::shared_ptr<Process> find(const ProcessHandle& handle) const;
+    // pid -1 if the slot is empty
+    ProcessHandle handleOf(ProcessID pid) const;
+
+    // Mirrors a live slot's state for sweeps; lock-free, and ignored once
+    // the slot has been vacated
+    void setState(ProcessID pid, ProcessState state);
+
+    size_t size() const { return size_.load(std::memory_order_relaxed); }
+    // Pages [0, pageCount()) cover every pid inserted so far
+    size_t pageCount() const { return page_count_.load(std::memory_order_acquire); }
+
+    // Calls visit(pid, process) for each occupied slot of a page, in pid
+    // order, under the page's shared lock
+    template<typename Visitor>
+    void forEach(size_t page, Visitor&& visit) const {
+        const Page* entries = pageAt(page);
+        if (!entries) {
+            return;
+        }
+        std::shared_lock<std::shared_mutex> lock(entries->mutex);
+        for (size_t slot = 0; slot < kPageSize; ++slot) {
+            if (stateOf(entries->words[slot].load(std::memory_order_relaxed)) != kVacant) {
+                visit(static_cast<ProcessID>(page * kPageSize + slot), entries->processes[slot]);
+            }
+        }
+    }
+
+    // As forEach, limited to slots whose mirrored state is state
+    template<typename Visitor>
+    void forEachInState(size_t page, ProcessState state, Visitor&& visit) const {
+        const Page* entries = pageAt(page);
+        if (!entries) {
+            return;
+        }
+        std::shared_lock<std::shared_mutex> lock(entries->mutex);
+        for (size_t slot = 0; slot < kPageSize; ++slot) {
+            if (stateOf(entries->words[slot].load(std::memory_order_relaxed)) == encode(state)) {
+                visit(static_cast<ProcessID>(page * kPageSize + slot), entries->processes[slot]);
+            }
+        }
+    }
+
+private:
+    // Slot word: generation << 8 | state, with kVacant for an empty slot.
+    // Only changed under the page lock, except for setState on a live slot.
+    static constexpr uint8_t kVacant = 0xff;
+    static uint8_t encode(ProcessState state) { return static_cast<uint8_t>(state); }
+    static uint8_t stateOf(uint64_t word) { return static_cast<uint8_t>(word); }
+    static uint32_t generationOf(uint64_t word) { return static_cast<uint32_t>(word >> 8); }
+    static uint64_t makeWord(uint32_t generation, uint8_t state) {
+        return (static_cast<uint64_t>(generation) << 8) | state;
+    }
+
+    struct alignas(64) Page {
+        Page();
+        mutable std::shared_mutex mutex;
+        std::array<std::atomic<uint64_t>, kPageSize> words;
+        std::array<std::shared_ptr<Process>, kPageSize> processes;
+    };
+
+    // Two-level directory over the non-negative pid range: kDirectorySize
+    // blocks of kBlockSize page pointers, both allocated on demand
+    static constexpr size_t kBlockSize = 4096;
+    static constexpr size_t kDirectorySize =
+        (size_t{1} << 31) / (kPageSize * kBlockSize);
+    using Block = std::array<std::atomic<Page*>, kBlockSize>;
+
+    const Page* pageAt(size_t page) const;
+    Page* pageFor(ProcessID pid, bool create);
+    // Caller holds the page lock exclusively
+    static bool fill(Page& page, size_t slot, const std::shared_ptr<Process>& process);
+    static std::shared_ptr<Process> vacate(Page& page, size_t slot, const Process* expected);
+
+    std::array<std::atomic<Block*>, kDirectorySize> directory_{};
+    std::atomic<size_t> page_count_{0};
+    std::atomic<size_t> size_{0};
+};
+
+} // namespace os_sim
@@ -0,0 +1,52 @@
+// include/process/ready_queue.hpp
+#pragma once
+#include "types.hpp"
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace os_sim {
+
+// Indexed max-heap of READY processes: highest priority first, FIFO among
+// equal priorities. A pid -> slot index makes priority updates and removals
+// O(log n). Not thread-safe; it lives in a per-CPU SchedulerPolicy, which
+// ProcessManager only uses under that CPU's Cpu::mutex.
+class ReadyQueue {
+public:
+    // Adds pid, or moves it behind its equal-priority peers if present
+    void push(ProcessID pid, Priority priority);
+    bool remove(ProcessID pid);
+    bool updatePriority(ProcessID pid, Priority priority);
+
+    std::optional<ProcessID> top() const;
+    std::optional<ProcessID> pop();
+
+    bool contains(ProcessID pid) const { return index_.count(pid) != 0; }
+    size_t size() const { return heap_.size(); }
+    bool empty() const { return heap_.empty(); }
+
+private:
+    struct Entry {
+        Priority priority;
+        uint64_t sequence;  // Arrival order, breaks priority ties
+        ProcessID pid;
+    };
+
+    static bool before(const Entry& lhs, const Entry& rhs) {
+        if (lhs.priority != rhs.priority) {
+            return lhs.priority > rhs.priority;
+        }
+        return lhs.sequence < rhs.sequence;
+    }
+
+    void place(size_t slot, Entry entry);
+    void siftUp(size_t slot);
+    void siftDown(size_t slot);
+    void erase(size_t slot);
+
+    std::vector<Entry> heap_;
+    std::unordered_map<ProcessID, size_t> index_;
+    uint64_t next_sequence_{0};
+};
+
+} // namespace os_sim
@@ -0,0 +1,200 @@
+// include/process/scheduler_policy.hpp
+#pragma once
+#include "process/ready_queue.hpp"
+#include "types.hpp"
+#include <array>
+#include <list>
+#include <memory>
+#include <optional>
+#include <random>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace os_sim {
+
+// Decides which READY process runs next. ProcessManager keeps one instance
+// per simulated CPU and drives it from its ProcessObserver hooks and once
+// per scheduling tick, always under that CPU's Cpu::mutex, so
+// implementations need no locking of their own.
+class SchedulerPolicy {
+public:
+    virtual ~SchedulerPolicy() = default;
+    virtual const char* getName() const = 0;
+
+    // pid became READY: created, resumed or preempted
+    virtual void enqueue(ProcessID pid, Priority priority) = 0;
+    // pid left READY other than through pickNext(); no-op if not queued
+    virtual void remove(ProcessID pid) = 0;
+    // Records a new priority for pid, queued or not
+    virtual void updatePriority(ProcessID pid, Priority priority) = 0;
+    // pid terminated; drops whatever the policy remembers about it
+    virtual void forget(ProcessID pid) = 0;
+
+    // Removes and returns the process to run next
+    virtual std::optional<ProcessID> pickNext() = 0;
+    // Charges one tick to the running process; true once its slice is used up
+    virtual bool tick(ProcessID running) = 0;
+
+    virtual size_t size() const = 0;
+};
+
+// Nice-style weight shared by the proportional-share policies: each priority
+// step is worth 25% more CPU, priority 0 weighs 1024. Clamped to [-20, 19].
+uint64_t priorityWeight(Priority priority);
+
+// Highest priority first, FIFO among equals; one-tick slices
+class PriorityPolicy : public SchedulerPolicy {
+public:
+    const char* getName() const override { return "priority"; }
+    void enqueue(ProcessID pid, Priority priority) override;
+    void remove(ProcessID pid) override;
+    void updatePriority(ProcessID pid, Priority priority) override;
+    void forget(ProcessID pid) override;
+    std::optional<ProcessID> pickNext() override;
+    bool tick(ProcessID running) override;
+    size_t size() const override { return queue_.size(); }
+
+private:
+    ReadyQueue queue_;
+};
+
+// Multilevel feedback queue. Processes start on the top level; using up a
+// level's allotment (which survives blocking) moves them one level down, and
+// every kBoostInterval ticks everybody returns to the top. Static priority
+// is ignored.
+class MlfqPolicy : public SchedulerPolicy {
+public:
+    static constexpr size_t kLevels = 3;
+    static constexpr uint32_t kBaseQuantum = 1;      // Ticks; doubles per level
+    static constexpr uint64_t kBoostInterval = 64;   // Ticks
+
+    const char* getName() const override { return "mlfq"; }
+    void enqueue(ProcessID pid, Priority priority) override;
+    void remove(ProcessID pid) override;
+    void updatePriority(ProcessID pid, Priority priority) override;
+    void forget(ProcessID pid) override;
+    std::optional<ProcessID> pickNext() override;
+    bool tick(ProcessID running) override;
+    size_t size() const override { return queued_; }
+
+private:
+    struct Entry {
+        size_t level{0};
+        uint32_t used{0};            // Ticks charged at the current level
+        bool queued{false};
+        std::list<ProcessID>::iterator position;
+    };
+
+    static uint32_t quantum(size_t level) { return kBaseQuantum << level; }
+    void boost();
+
+    std::array<std::list<ProcessID>, kLevels> levels_;
+    std::unordered_map<ProcessID, Entry> entries_;
+    size_t queued_{0};
+    uint64_t ticks_{0};
+};
+
+// CFS-style fair scheduler: READY processes sit in a balanced tree keyed by
+// virtual runtime, which advances by kTickNs scaled down by the process
+// weight. The leftmost process runs until it is kGranularityNs of virtual
+// time ahead of the next one.
+class CfsPolicy : public SchedulerPolicy {
+public:
+    static constexpr uint64_t kTickNs = 1000000;
+    static constexpr uint64_t kGranularityNs = kTickNs;
+
+    const char* getName() const override { return "cfs"; }
+    void enqueue(ProcessID pid, Priority priority) override;
+    void remove(ProcessID pid) override;
+    void updatePriority(ProcessID pid, Priority priority) override;
+    void forget(ProcessID pid) override;
+    std::optional<ProcessID> pickNext() override;
+    bool tick(ProcessID running) override;
+    size_t size() const override { return timeline_.size(); }
+
+private:
+    struct Entry {
+        uint64_t vruntime{0};
+        uint64_t weight{0};
+        bool queued{false};
+    };
+
+    Entry& entryFor(ProcessID pid, Priority priority);
+
+    std::set<std::pair<uint64_t, ProcessID>> timeline_;
+    std::unordered_map<ProcessID, Entry> entries_;
+    // Never moves backwards; processes that slept are brought up to it so
+    // they cannot hoard credit
+    uint64_t min_vruntime_{0};
+};
+
+// Stride scheduling: deterministic proportional share. Each process has
+// kStride1 / weight as its stride; the lowest pass runs for one tick and
+// its pass advances by its stride.
+class StridePolicy : public SchedulerPolicy {
+public:
+    static constexpr uint64_t kStride1 = uint64_t(1) << 24;
+
+    const char* getName() const override { return "stride"; }
+    void enqueue(ProcessID pid, Priority priority) override;
+    void remove(ProcessID pid) override;
+    void updatePriority(ProcessID pid, Priority priority) override;
+    void forget(ProcessID pid) override;
+    std::optional<ProcessID> pickNext() override;
+    bool tick(ProcessID running) override;
+    size_t size() const override { return queue_.size(); }
+
+private:
+    struct Entry {
+        uint64_t pass{0};
+        uint64_t stride{0};
+        bool queued{false};
+    };
+
+    Entry& entryFor(ProcessID pid, Priority priority);
+
+    std::set<std::pair<uint64_t, ProcessID>> queue_;
+    std::unordered_map<ProcessID, Entry> entries_;
+    uint64_t global_pass_{0};
+};
+
+// Lottery scheduling: randomized proportional share with priorityWeight()
+// tickets. Queued processes hold slots in a Fenwick tree of ticket counts,
+// so drawing the winner is a single O(log n) descent.
+class LotteryPolicy : public SchedulerPolicy {
+public:
+    explicit LotteryPolicy(uint64_t seed = 0x5eed);
+
+    const char* getName() const override { return "lottery"; }
+    void enqueue(ProcessID pid, Priority priority) override;
+    void remove(ProcessID pid) override;
+    void updatePriority(ProcessID pid, Priority priority) override;
+    void forget(ProcessID pid) override;
+    std::optional<ProcessID> pickNext() override;
+    bool tick(ProcessID running) override;
+    size_t size() const override { return slots_.size(); }
+
+private:
+    void add(size_t slot, int64_t delta);
+    uint64_t prefix(size_t count) const;  // Tickets in slots [0, count)
+    size_t find(uint64_t ticket) const;   // Slot holding the given ticket
+    void release(size_t slot);
+
+    std::vector<uint64_t> tree_;          // 1-based Fenwick tree
+    std::vector<ProcessID> slot_pids_;
+    std::vector<uint64_t> slot_tickets_;
+    std::vector<size_t> free_slots_;
+    std::unordered_map<ProcessID, size_t> slots_;       // Queued processes
+    std::unordered_map<ProcessID, uint64_t> tickets_;   // Known processes
+    uint64_t total_tickets_{0};
+    std::mt19937_64 random_;
+};
+
+// nullptr for an unknown name
+std::unique_ptr<SchedulerPolicy> makeSchedulerPolicy(const std::string& name);
+const std::vector<std::string>& schedulerPolicyNames();
+
+} // namespace os_sim
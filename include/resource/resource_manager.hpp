@@ -1,14 +1,21 @@
 // include/resource/resource_manager.hpp
 #pragma once
 #include "types.hpp"
+#include "resource/resource_pool.hpp"
 #include <unordered_map>
 #include <vector>
 #include <mutex>
 #include <memory>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <iostream>  
 
 namespace os_sim {
 
+class ThreadPool;
+
 class ResourceManager {
 public:
     static ResourceManager& getInstance();
@@ -22,17 +29,49 @@ public:
     ErrorCode releaseResource(ProcessID pid, ResourceID resource_id);
     bool isResourceAvailable(ResourceID resource_id) const;
 
+    // Blocking allocateResource. Waiters queue per resource in arrival
+    // order and a release hands the resource straight to the first one,
+    // waking only that thread. A process waits for one resource at a time.
+    // RESOURCE_NOT_AVAILABLE on timeout, DEADLOCK_DETECTED if
+    // resolveDeadlock chose this wait, OPERATION_FAILED if it was
+    // cancelled or pid already holds or waits. A caller's lock passed as
+    // held is released once pid is queued (or before returning if it is
+    // not), so cancelWait under that lock cannot miss the wait.
+    static constexpr std::chrono::milliseconds kWaitForever = std::chrono::milliseconds::max();
+    ErrorCode acquireResource(ProcessID pid, ResourceID resource_id,
+                              std::chrono::milliseconds timeout = kWaitForever,
+                              std::unique_lock<std::mutex>* held = nullptr);
+    // Ends pid's wait, if it has one, with OPERATION_FAILED
+    void cancelWait(ProcessID pid);
+
+    // Counted units per resource type, separate from the resources above.
+    // A process that declares a maximum claim (one entry per type) is
+    // admitted with the Banker's algorithm; see ResourcePool.
+    ErrorCode setResourceUnits(ResourceType type, ResourceUnits total);
+    ErrorCode declareMaxClaim(ProcessID pid, const std::vector<ResourceUnits>& claim);
+    ErrorCode allocate(ProcessID pid, ResourceType type, ResourceUnits units);
+    ErrorCode release(ProcessID pid, ResourceType type, ResourceUnits units);
+    void releaseAllUnits(ProcessID pid);
+    ResourceUnits getTotalUnits(ResourceType type) const;
+    ResourceUnits getAvailableUnits(ResourceType type) const;
+    ResourceUnits getAllocatedUnits(ProcessID pid, ResourceType type) const;
+
     // Resource information
     std::vector<ResourceID> getAvailableResources() const;
     std::vector<ResourceID> getProcessResources(ProcessID pid) const;
     
-    // Deadlock management
+    // Deadlock management over the wait-for graph: a process blocked in
+    // acquireResource waits for the holder of its resource. Resolving
+    // fails the wait of the highest pid on each cycle.
     bool detectDeadlock();
     void resolveDeadlock();
 
     // System statistics
     size_t getResourceCount() const;
     size_t getAllocatedResourceCount() const;
+
+    // Pool used for table-wide sweeps; nullptr sweeps on the calling thread
+    void setThreadPool(ThreadPool* pool);
     
     // Resource type information
     ResourceType getResourceType(ResourceID id) const {
@@ -50,6 +89,12 @@ public:
         }
         return result;
     }
+
+    // Wait-for edges: each blocked process and the resource it waits for
+    std::vector<std::pair<ProcessID, ResourceID>> getWaits() const {
+        std::lock_guard<std::mutex> lock(resource_mutex_);
+        return {waiting_for_.begin(), waiting_for_.end()};
+    }
     
 private:
     // Private constructor for singleton
@@ -61,16 +106,38 @@ private:
     // Initialize default resources
     void initializeDefaultResources();
 
+    // A thread blocked in acquireResource, on its own stack
+    struct Waiter {
+        explicit Waiter(ProcessID pid) : pid(pid) {}
+
+        ProcessID pid;
+        std::condition_variable cv;
+        ErrorCode result{ErrorCode::OPERATION_FAILED};
+        bool done{false};
+    };
+
     // Member variables
     std::unordered_map<ResourceID, ResourceType> resources_;
     std::unordered_map<ResourceID, ProcessID> allocations_;
     std::unordered_map<ProcessID, std::vector<ResourceID>> process_resources_;
+    // Only held resources have waiters; a release hands over to the front
+    std::unordered_map<ResourceID, std::deque<Waiter*>> wait_queues_;
+    std::unordered_map<ProcessID, ResourceID> waiting_for_;
+    ResourcePool units_{kResourceTypeCount};
     
     mutable std::mutex resource_mutex_;
     ResourceID next_resource_id_{0};
+    std::atomic<ThreadPool*> thread_pool_{nullptr};
+
+    // Tables smaller than this are swept serially
+    static constexpr size_t kParallelSweepThreshold = 4096;
 
-    // Helper methods
-    bool hasCycle(std::vector<bool>& visited, std::vector<bool>& rec_stack, ProcessID pid);
+    // Helper methods; callers hold resource_mutex_
+    void grant(ProcessID pid, ResourceID resource_id);
+    ErrorCode giveBack(ProcessID pid, ResourceID resource_id);
+    Waiter* findWaiter(ProcessID pid) const;
+    void endWait(Waiter& waiter, ErrorCode result);
+    std::vector<ProcessID> findCycle() const;
 };
 
 } // namespace os_sim
\ No newline at end of file
@@ -0,0 +1,82 @@
+// include/resource/resource_pool.hpp
+#pragma once
+#include "types.hpp"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace os_sim {
+
+using ResourceUnits = uint32_t;
+
+// Counted resource classes with Banker's-algorithm admission. Each class
+// has a total and an available number of units; a process may declare
+// its maximum claim per class, and a grant is refused if no order
+// remains in which every process can still reach its claim and finish.
+// A process without a claim may hold units but is assumed to ask for
+// nothing more. Not thread-safe; the owner serializes calls.
+//
+// Per-process rows are stored one column per class, so the safety check
+// compares a whole column against one available count in a loop the
+// compiler vectorizes.
+class ResourcePool {
+public:
+    explicit ResourcePool(size_t classes);
+
+    size_t getClassCount() const { return total_.size(); }
+
+    // Sets a class's total; fails if units are held beyond it or the
+    // smaller pool would be unsafe
+    ErrorCode setTotal(size_t resource_class, ResourceUnits units);
+    ResourceUnits getTotal(size_t resource_class) const { return total_[resource_class]; }
+    ResourceUnits getAvailable(size_t resource_class) const {
+        return available_[resource_class];
+    }
+
+    // Declares pid's maximum claim, one entry per class. Fails with
+    // RESOURCE_NOT_AVAILABLE past a total, INVALID_STATE below what pid
+    // already holds, and DEADLOCK_DETECTED if the state would be unsafe.
+    ErrorCode declareClaim(ProcessID pid, const std::vector<ResourceUnits>& claim);
+
+    // RESOURCE_NOT_AVAILABLE if fewer units are free, OPERATION_FAILED
+    // past pid's claim, DEADLOCK_DETECTED if granting would be unsafe
+    ErrorCode allocate(ProcessID pid, size_t resource_class, ResourceUnits units);
+    ErrorCode release(ProcessID pid, size_t resource_class, ResourceUnits units);
+    // Drops pid's claim and returns everything it holds
+    void releaseAll(ProcessID pid);
+
+    ResourceUnits getAllocated(ProcessID pid, size_t resource_class) const;
+    ResourceUnits getNeed(ProcessID pid, size_t resource_class) const;
+
+    // Full safety check of the current state
+    bool isSafe() const;
+
+private:
+    size_t rowFor(ProcessID pid);
+    void removeRow(size_t row);
+    void grant(size_t row, size_t resource_class, ResourceUnits units);
+    void revoke(size_t row, size_t resource_class, ResourceUnits units);
+    // Called after a grant to row from a safe state
+    bool staysSafe(size_t row) const;
+
+    std::vector<ResourceUnits> total_;
+    std::vector<ResourceUnits> available_;
+    // Sum of need per class; when available covers it, every process can
+    // finish at once
+    std::vector<uint64_t> need_total_;
+
+    // Row r belongs to pids_[r]; rows are swapped out on removal
+    std::vector<ProcessID> pids_;
+    std::vector<uint8_t> claimed_;
+    std::unordered_map<ProcessID, size_t> row_of_;
+    // [class][row]
+    std::vector<std::vector<ResourceUnits>> allocation_;
+    std::vector<std::vector<ResourceUnits>> need_;
+
+    // Scratch for the full check, kept to avoid allocating per call
+    mutable std::vector<uint32_t> finished_;
+    mutable std::vector<uint32_t> runnable_;
+    mutable std::vector<ResourceUnits> work_;
+};
+
+} // namespace os_sim
@@ -0,0 +1,52 @@
+// include/sim/calendar_queue.hpp
+#pragma once
+#include "sim/event.hpp"
+#include <cstddef>
+#include <vector>
+
+namespace os_sim {
+
+// Calendar queue (R. Brown, 1988): a ring of buckets, each covering width_
+// nanoseconds of one "year" of bucket_count * width_. Dequeue scans forward
+// from the current bucket, so with the width tuned to the event spacing
+// both push and pop are O(1) amortized. The ring doubles or halves as the
+// queue grows or shrinks, and the width is re-estimated from the earliest
+// events each time. Not thread-safe.
+class CalendarQueue {
+public:
+    CalendarQueue();
+
+    void push(const Event& event);
+    // Earliest event by (time, sequence); the queue must not be empty
+    Event pop();
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_t bucketCount() const { return buckets_.size(); }
+    SimTime bucketWidth() const { return width_; }
+
+private:
+    static constexpr size_t kMinBuckets = 16;
+    static constexpr size_t kWidthSample = 25;
+
+    size_t bucketOf(SimTime time) const {
+        return static_cast<size_t>(time / width_) & (buckets_.size() - 1);
+    }
+    void insert(const Event& event);
+    void moveTo(SimTime time);
+    void resize(size_t bucket_count);
+
+    // Each bucket is sorted latest first, so its earliest event is back()
+    std::vector<std::vector<Event>> buckets_;
+    SimTime width_{1};
+    size_t size_{0};
+
+    // Every queued event is at or after start_; current_ is its bucket and
+    // bucket_top_ the end of that bucket's range in the current year
+    SimTime start_{0};
+    size_t current_{0};
+    SimTime bucket_top_{1};
+    size_t pops_since_resize_{0};
+};
+
+} // namespace os_sim
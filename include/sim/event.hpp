@@ -0,0 +1,50 @@
+// include/sim/event.hpp
+#pragma once
+#include <cstdint>
+
+namespace os_sim {
+
+// Virtual time in nanoseconds since the start of a simulation run
+using SimTime = uint64_t;
+
+enum class EventType : uint8_t {
+    PROCESS_ARRIVAL,
+    SLICE_END,          // The running process used up its current CPU slice
+    IO_COMPLETE,
+    RESOURCE_REQUEST,
+    MESSAGE_DELIVER,
+    CUSTOM
+};
+
+// Plain value so queues can store events inline. The meaning of pid, target
+// and arg depends on the type; sequence is assigned by EventEngine and
+// orders events scheduled for the same time.
+struct Event {
+    SimTime time{0};
+    uint64_t sequence{0};
+    EventType type{EventType::CUSTOM};
+    int32_t pid{-1};
+    int32_t target{-1};
+    uint64_t arg{0};
+};
+
+inline bool runsBefore(const Event& lhs, const Event& rhs) {
+    if (lhs.time != rhs.time) {
+        return lhs.time < rhs.time;
+    }
+    return lhs.sequence < rhs.sequence;
+}
+
+inline const char* toString(EventType type) {
+    switch (type) {
+        case EventType::PROCESS_ARRIVAL: return "PROCESS_ARRIVAL";
+        case EventType::SLICE_END: return "SLICE_END";
+        case EventType::IO_COMPLETE: return "IO_COMPLETE";
+        case EventType::RESOURCE_REQUEST: return "RESOURCE_REQUEST";
+        case EventType::MESSAGE_DELIVER: return "MESSAGE_DELIVER";
+        case EventType::CUSTOM: return "CUSTOM";
+        default: return "UNKNOWN";
+    }
+}
+
+} // namespace os_sim
@@ -0,0 +1,49 @@
+// include/sim/event_engine.hpp
+#pragma once
+#include "sim/calendar_queue.hpp"
+#include "sim/event.hpp"
+#include <functional>
+#include <limits>
+
+namespace os_sim {
+
+// Discrete-event core: a virtual clock that jumps from one event to the
+// next instead of waiting on the wall clock. Events scheduled for the same
+// time run in the order they were scheduled, so a run is a pure function of
+// its inputs. Single-threaded; the handler may schedule further events.
+class EventEngine {
+public:
+    using Handler = std::function<void(const Event&)>;
+    static constexpr SimTime kForever = std::numeric_limits<SimTime>::max();
+
+    explicit EventEngine(Handler handler = nullptr);
+
+    void setHandler(Handler handler) { handler_ = std::move(handler); }
+
+    SimTime now() const { return now_; }
+
+    // Schedules an event delay after now(). Returns its sequence number.
+    uint64_t schedule(SimTime delay, EventType type, int32_t pid = -1,
+                      int32_t target = -1, uint64_t arg = 0);
+    // Absolute variant; times before now() run at now()
+    uint64_t scheduleAt(SimTime time, EventType type, int32_t pid = -1,
+                        int32_t target = -1, uint64_t arg = 0);
+
+    // Advances the clock to the next event and handles it; false if none
+    bool step();
+    // Handles events up to and including until; with a finite limit the
+    // clock ends there. Returns the number of events handled.
+    uint64_t run(SimTime until = kForever);
+
+    size_t pending() const { return queue_.size(); }
+    uint64_t processed() const { return processed_; }
+
+private:
+    CalendarQueue queue_;
+    Handler handler_;
+    SimTime now_{0};
+    uint64_t next_sequence_{0};
+    uint64_t processed_{0};
+};
+
+} // namespace os_sim
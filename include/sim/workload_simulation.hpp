@@ -0,0 +1,124 @@
+// include/sim/workload_simulation.hpp
+#pragma once
+#include "process/scheduler_policy.hpp"
+#include "sim/event_engine.hpp"
+#include "types.hpp"
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace os_sim {
+
+// Synthetic workload for a discrete-event run. Times are virtual ns.
+struct SimulationConfig {
+    uint64_t seed{1};
+    size_t processes{10000};           // Lifecycles to replay
+    size_t cpus{1};
+    std::string policy{"priority"};    // See schedulerPolicyNames()
+    SimTime quantum{1000000};          // One scheduler tick
+
+    // Defaults keep one CPU about 80% busy
+    SimTime mean_interarrival{5000000};
+    size_t mean_bursts{4};             // CPU bursts per process, 1..2*mean-1
+    SimTime mean_burst{1000000};       // CPU time per burst
+    SimTime mean_io{5000000};          // Blocking time between bursts
+    Priority max_priority{4};          // Priorities drawn from 0..max_priority
+
+    size_t resources{8};               // Exclusive resources, FIFO waiters
+    double resource_probability{0.2};  // Chance a burst needs one
+    double message_probability{0.1};   // Chance a burst ends with a message
+                                       // to one of the latest arrivals
+    SimTime message_latency{50000};
+};
+
+struct SimulationResult {
+    SimTime end_time{0};
+    uint64_t events{0};
+    size_t completed{0};
+
+    double mean_turnaround_ms{0.0};    // Arrival to exit
+    double p99_turnaround_ms{0.0};
+    double mean_ready_wait_ms{0.0};    // Time spent READY per dispatch
+    double cpu_utilization{0.0};       // Busy share of cpus * end_time
+
+    uint64_t dispatches{0};
+    uint64_t migrations{0};
+    uint64_t resource_waits{0};        // Requests that found the resource held
+    uint64_t messages_delivered{0};
+    uint64_t messages_dropped{0};      // Receiver had already exited
+
+    double wall_seconds{0.0};
+};
+
+// Replays process lifecycles (arrival, CPU bursts scheduled by a
+// SchedulerPolicy per simulated CPU, I/O waits, exclusive resources and
+// messages) on an EventEngine. Nothing touches the wall clock or the live
+// ProcessManager, so the same config always yields the same result.
+class WorkloadSimulation {
+public:
+    // Throws std::invalid_argument for an unknown policy or zero CPUs
+    explicit WorkloadSimulation(SimulationConfig config);
+
+    SimulationResult run();
+
+private:
+    static constexpr size_t kMessagePeers = 64;
+
+    struct SimProcess {
+        Priority priority{0};
+        ProcessState state{ProcessState::NEW};
+        uint32_t cpu{0};
+        uint32_t bursts_left{0};
+        SimTime burst_left{0};
+        SimTime arrival{0};
+        SimTime ready_since{0};
+        int32_t resource{-1};          // Held during the current burst
+    };
+
+    struct SimCpu {
+        std::unique_ptr<SchedulerPolicy> policy;
+        int32_t running{-1};
+        size_t ready{0};
+        SimTime busy{0};
+    };
+
+    struct SimResource {
+        int32_t holder{-1};
+        std::deque<int32_t> waiters;
+    };
+
+    void handle(const Event& event);
+    void onArrival(int32_t pid);
+    void onSliceEnd(int32_t pid, SimTime slice);
+    void onIoComplete(int32_t pid);
+    void onResourceRequest(int32_t pid, int32_t resource);
+    void onMessage(int32_t receiver);
+
+    void beginBurst(int32_t pid);
+    void makeReady(int32_t pid);
+    void dispatch(size_t cpu);
+    void startSlice(int32_t pid);
+    void finishBurst(int32_t pid);
+    void releaseResource(int32_t pid);
+    size_t leastLoadedCpu() const;
+
+    // Deterministic on every platform, unlike the <random> distributions
+    uint64_t nextRandom();
+    double uniform();
+    SimTime exponential(SimTime mean);
+
+    SimulationConfig config_;
+    EventEngine engine_;
+    std::vector<SimProcess> processes_;
+    std::vector<SimCpu> cpus_;
+    std::vector<SimResource> resources_;
+    std::vector<SimTime> turnarounds_;
+    uint64_t random_state_;
+
+    SimulationResult result_;
+    SimTime total_ready_wait_{0};
+};
+
+} // namespace os_sim
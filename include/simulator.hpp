@@ -1,11 +1,13 @@
 // include/simulator.hpp
 #pragma once
+#include "process/process_event_bus.hpp"
 #include "thread/thread_pool.hpp"
 #include <string>
 #include <functional>
 #include <map>
 #include <vector>
 #include <memory>
+#include <thread>
 
 namespace os_sim {
 
@@ -13,6 +15,12 @@ class Simulator {
 public:
     static Simulator& getInstance();
 
+    // Worker placement for the thread pool; must be called before initialize()
+    void setWorkerAffinity(AffinityPolicy policy, std::vector<int> cpus = {});
+
+    // Simulated CPUs for process scheduling; must be called before initialize()
+    void setSimulatedCpus(size_t count) { simulated_cpus_ = count; }
+
     // Initialize the simulator
     void initialize();
     
@@ -38,6 +46,13 @@ private:
     
     // System components
     std::unique_ptr<ThreadPool> thread_pool_;
+    AffinityPolicy worker_affinity_ = AffinityPolicy::NONE;
+    std::vector<int> worker_cpus_;
+    size_t simulated_cpus_ = 1;
+    // Process event subscription behind the events command, -1 when off
+    SubscriberID event_subscriber_ = -1;
+    // One thread per blocking acquire, joined at shutdown
+    std::vector<std::thread> waiters_;
     
     // Command processing helpers
     void setupCommandHandlers();
@@ -50,13 +65,21 @@ private:
     void handleListProcesses();
     void handleProcessInfo(const std::vector<std::string>& args);
     void handleAllocateResource(const std::vector<std::string>& args);
+    void handleAcquireResource(const std::vector<std::string>& args);
     void handleReleaseResource(const std::vector<std::string>& args);
+    void handleResourceUnits(const std::vector<std::string>& args);
+    void handleDeclareClaim(const std::vector<std::string>& args);
     void handleCheckDeadlock();
     void handleSystemStatus();
     void handleListResources();  
     void handleStartCalculator(const std::vector<std::string>& args);
     void handleSuspendProcess(const std::vector<std::string>& args);
     void handleResumeProcess(const std::vector<std::string>& args);
+    void handleSchedulerPolicy(const std::vector<std::string>& args);
+    void handleRunScheduler(const std::vector<std::string>& args);
+    void handleSimulateWorkload(const std::vector<std::string>& args);
+    void handleEvents(const std::vector<std::string>& args);
+    void handlePipeline(const std::vector<std::string>& args);
 };
 
 } // namespace os_sim
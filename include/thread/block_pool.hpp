@@ -0,0 +1,47 @@
+// include/thread/block_pool.hpp
+#pragma once
+#include <cstddef>
+#include <new>
+
+namespace os_sim {
+
+// Size-class allocator for small, short-lived objects (tasks, future shared
+// states). Each thread keeps a private free list per size class and trades
+// whole batches with a global list, so steady-state allocate/deallocate never
+// reaches the system allocator. Blocks are never returned to the OS.
+class BlockPool {
+public:
+    static constexpr size_t kBlockAlignment = 64;
+    static constexpr size_t kMaxBlockSize = 512;
+
+    static void* allocate(size_t size);
+    static void deallocate(void* ptr, size_t size) noexcept;
+};
+
+// Standard allocator adaptor over BlockPool, e.g. for std::promise
+template<typename T>
+class PoolAllocator {
+public:
+    using value_type = T;
+
+    PoolAllocator() noexcept = default;
+    template<typename U>
+    PoolAllocator(const PoolAllocator<U>&) noexcept {}
+
+    T* allocate(size_t n) {
+        static_assert(alignof(T) <= BlockPool::kBlockAlignment,
+                      "PoolAllocator does not support over-aligned types");
+        return static_cast<T*>(BlockPool::allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* ptr, size_t n) noexcept {
+        BlockPool::deallocate(ptr, n * sizeof(T));
+    }
+
+    template<typename U>
+    bool operator==(const PoolAllocator<U>&) const noexcept { return true; }
+    template<typename U>
+    bool operator!=(const PoolAllocator<U>&) const noexcept { return false; }
+};
+
+} // namespace os_sim
@@ -0,0 +1,33 @@
+// include/thread/cpu_topology.hpp
+#pragma once
+#include <string>
+#include <vector>
+
+namespace os_sim {
+
+// Snapshot of the CPUs this process may run on and the NUMA node of each.
+// On platforms without topology information every CPU is on node 0.
+class CpuTopology {
+public:
+    static const CpuTopology& get();
+
+    // Usable CPUs, ordered by node and then by CPU number
+    const std::vector<int>& getCpus() const { return cpus_; }
+    size_t getNodeCount() const { return node_count_; }
+    int getNodeOf(int cpu) const;
+
+    // Parses Linux cpulist syntax, e.g. "0-3,8,10-11"
+    static std::vector<int> parseCpuList(const std::string& list);
+
+    // Pins the calling thread to one CPU; false if unsupported or rejected
+    static bool pinCurrentThread(int cpu);
+
+private:
+    CpuTopology();
+
+    std::vector<int> cpus_;
+    std::vector<int> cpu_nodes_;  // Indexed by CPU number
+    size_t node_count_;
+};
+
+} // namespace os_sim
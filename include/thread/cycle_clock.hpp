@@ -0,0 +1,29 @@
+// include/thread/cycle_clock.hpp
+#pragma once
+#include <cstdint>
+
+namespace os_sim {
+
+// Monotonic nanosecond clock for accounting on hot paths. With an
+// invariant TSC (x86-64) a reading is one rdtsc and a multiply, scaled by
+// a rate calibrated once against CLOCK_MONOTONIC; without one it reads
+// CLOCK_MONOTONIC. Only differences between readings mean anything.
+class CycleClock {
+public:
+    static uint64_t now();
+    // False when readings come from CLOCK_MONOTONIC
+    static bool usesTsc();
+
+private:
+    struct Calibration {
+        bool tsc{false};
+        uint64_t base_cycles{0};
+        uint64_t base_ns{0};
+        uint64_t ns_per_cycle{0};  // Fixed point, see kRateShift
+    };
+
+    static const Calibration& calibration();
+    static uint64_t monotonicNow();
+};
+
+} // namespace os_sim
@@ -0,0 +1,63 @@
+// include/thread/latency_histogram.hpp
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace os_sim {
+
+// Percentiles of a LatencyHistogram, all in nanoseconds. Percentiles are
+// bucket upper bounds, so they overstate the true value by at most 1/16.
+struct LatencySummary {
+    uint64_t count{0};
+    double mean{0.0};
+    uint64_t p50{0};
+    uint64_t p99{0};
+    uint64_t p999{0};
+    uint64_t max{0};
+};
+
+// Log-linear histogram of nanosecond durations: each power of two is split
+// into kSubBuckets linear buckets. Written by a single thread with relaxed
+// load/store pairs (no read-modify-write), so recording never contends;
+// any thread may read it concurrently and sees a slightly stale view.
+class LatencyHistogram {
+public:
+    static constexpr size_t kSubBucketBits = 4;
+    static constexpr size_t kSubBuckets = size_t(1) << kSubBucketBits;
+    static constexpr size_t kBucketCount = (64 - kSubBucketBits + 1) * kSubBuckets;
+
+    void record(uint64_t nanoseconds) {
+        bump(buckets_[bucketOf(nanoseconds)], 1);
+        bump(count_, 1);
+        bump(sum_, nanoseconds);
+        if (nanoseconds > max_.load(std::memory_order_relaxed)) {
+            max_.store(nanoseconds, std::memory_order_relaxed);
+        }
+    }
+
+    // Adds other's samples to this histogram; this one must not have a
+    // concurrent writer (used to merge per-worker histograms for reporting)
+    void merge(const LatencyHistogram& other);
+
+    uint64_t getCount() const { return count_.load(std::memory_order_relaxed); }
+    LatencySummary summarize() const;
+
+    static size_t bucketOf(uint64_t value);
+    static uint64_t bucketUpperBound(size_t bucket);
+
+private:
+    static void bump(std::atomic<uint64_t>& counter, uint64_t amount) {
+        counter.store(counter.load(std::memory_order_relaxed) + amount,
+                      std::memory_order_relaxed);
+    }
+
+    uint64_t percentile(double quantile) const;
+
+    std::atomic<uint64_t> buckets_[kBucketCount] = {};
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sum_{0};
+    std::atomic<uint64_t> max_{0};
+};
+
+} // namespace os_sim
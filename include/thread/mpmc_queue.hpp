@@ -0,0 +1,113 @@
+// include/thread/mpmc_queue.hpp
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace os_sim {
+
+// Bounded multi-producer multi-consumer ring (Dmitry Vyukov's design).
+// Every cell carries a sequence number that tells producers and consumers
+// whose turn it is, so both sides claim a position with a single CAS and
+// never block each other. Capacity is rounded up to a power of two.
+template<typename T>
+class MpmcQueue {
+public:
+    explicit MpmcQueue(size_t capacity)
+        : mask_(roundUp(capacity) - 1)
+        , cells_(new Cell[mask_ + 1])
+    {
+        for (size_t i = 0; i <= mask_; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    // False if the queue is full
+    bool tryPush(T value) {
+        size_t position = enqueue_pos_.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &cells_[position & mask_];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(sequence - position);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(position, position + 1,
+                                                       std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;  // Cell still holds the value from one lap ago
+            } else {
+                position = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->value = std::move(value);
+        cell->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    // False if the queue is empty
+    bool tryPop(T& value) {
+        size_t position = dequeue_pos_.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &cells_[position & mask_];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(sequence - (position + 1));
+            if (diff == 0) {
+                if (dequeue_pos_.compare_exchange_weak(position, position + 1,
+                                                       std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;  // Producer has not filled this cell yet
+            } else {
+                position = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        value = std::move(cell->value);
+        cell->sequence.store(position + mask_ + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t capacity() const { return mask_ + 1; }
+
+    // Approximate while producers or consumers are active
+    size_t size() const {
+        size_t tail = enqueue_pos_.load(std::memory_order_relaxed);
+        size_t head = dequeue_pos_.load(std::memory_order_relaxed);
+        return tail >= head ? tail - head : 0;
+    }
+
+    bool full() const { return size() >= capacity(); }
+
+private:
+    // One cell per cache line: neighbouring producers would otherwise keep
+    // stealing the line from each other
+    struct alignas(64) Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    static size_t roundUp(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        return size;
+    }
+
+    const size_t mask_;
+    std::unique_ptr<Cell[]> cells_;
+
+    alignas(64) std::atomic<size_t> enqueue_pos_{0};
+    alignas(64) std::atomic<size_t> dequeue_pos_{0};
+};
+
+} // namespace os_sim
@@ -0,0 +1,130 @@
+// include/thread/task.hpp
+#pragma once
+#include "thread/block_pool.hpp"
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace os_sim {
+
+// Move-only, type-erased void() callable. Callables up to kInlineSize bytes
+// are stored inline; larger ones are placed in a BlockPool block, so building
+// and running a Task does not touch the system allocator in the common case.
+class Task {
+public:
+    static constexpr size_t kInlineSize = 64;
+
+    Task() noexcept = default;
+
+    template<class F,
+             class = typename std::enable_if<
+                 !std::is_same<typename std::decay<F>::type, Task>::value>::type>
+    Task(F&& f) {
+        using Callable = typename std::decay<F>::type;
+        if constexpr (fitsInline<Callable>()) {
+            new (storage_) Callable(std::forward<F>(f));
+            ops_ = &InlineOps<Callable>::ops;
+        } else {
+            void* block = BlockPool::allocate(sizeof(Callable));
+            try {
+                new (block) Callable(std::forward<F>(f));
+            } catch (...) {
+                BlockPool::deallocate(block, sizeof(Callable));
+                throw;
+            }
+            *reinterpret_cast<void**>(storage_) = block;
+            ops_ = &PooledOps<Callable>::ops;
+        }
+    }
+
+    Task(Task&& other) noexcept {
+        moveFrom(other);
+    }
+
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    ~Task() { reset(); }
+
+    void operator()() { ops_->invoke(storage_); }
+
+    explicit operator bool() const noexcept { return ops_ != nullptr; }
+
+    void reset() noexcept {
+        if (ops_) {
+            ops_->destroy(storage_);
+            ops_ = nullptr;
+        }
+    }
+
+private:
+    struct Ops {
+        void (*invoke)(void* storage);
+        void (*relocate)(void* dst, void* src) noexcept;
+        void (*destroy)(void* storage) noexcept;
+    };
+
+    template<class Callable>
+    static constexpr bool fitsInline() {
+        return sizeof(Callable) <= kInlineSize &&
+               alignof(Callable) <= alignof(std::max_align_t) &&
+               std::is_nothrow_move_constructible<Callable>::value;
+    }
+
+    template<class Callable>
+    struct InlineOps {
+        static void invoke(void* storage) {
+            (*static_cast<Callable*>(storage))();
+        }
+        static void relocate(void* dst, void* src) noexcept {
+            auto* from = static_cast<Callable*>(src);
+            new (dst) Callable(std::move(*from));
+            from->~Callable();
+        }
+        static void destroy(void* storage) noexcept {
+            static_cast<Callable*>(storage)->~Callable();
+        }
+        static constexpr Ops ops{&invoke, &relocate, &destroy};
+    };
+
+    template<class Callable>
+    struct PooledOps {
+        static Callable* get(void* storage) {
+            return static_cast<Callable*>(*static_cast<void**>(storage));
+        }
+        static void invoke(void* storage) {
+            (*get(storage))();
+        }
+        static void relocate(void* dst, void* src) noexcept {
+            *static_cast<void**>(dst) = *static_cast<void**>(src);
+        }
+        static void destroy(void* storage) noexcept {
+            Callable* callable = get(storage);
+            callable->~Callable();
+            BlockPool::deallocate(callable, sizeof(Callable));
+        }
+        static constexpr Ops ops{&invoke, &relocate, &destroy};
+    };
+
+    void moveFrom(Task& other) noexcept {
+        if (other.ops_) {
+            other.ops_->relocate(storage_, other.storage_);
+            ops_ = other.ops_;
+            other.ops_ = nullptr;
+        }
+    }
+
+    alignas(std::max_align_t) unsigned char storage_[kInlineSize];
+    const Ops* ops_ = nullptr;
+};
+
+} // namespace os_sim
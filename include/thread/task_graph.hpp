@@ -0,0 +1,93 @@
+// include/thread/task_graph.hpp
+#pragma once
+#include "thread/task.hpp"
+#include "thread/thread_pool.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <initializer_list>
+#include <mutex>
+#include <vector>
+
+namespace os_sim {
+
+// Dependency graph of tasks executed on a ThreadPool. A node is posted to
+// the pool by whichever worker finishes its last predecessor, so no worker
+// ever blocks waiting on another task. The graph can be run again once the
+// previous run has completed.
+class TaskGraph {
+public:
+    using NodeId = size_t;
+
+    TaskGraph() = default;
+    ~TaskGraph();
+
+    TaskGraph(const TaskGraph&) = delete;
+    TaskGraph& operator=(const TaskGraph&) = delete;
+
+    // Adds a node that runs after every node in dependencies
+    template<class F>
+    NodeId addTask(F&& fn, std::initializer_list<NodeId> dependencies = {},
+                   const TaskOptions& options = TaskOptions());
+    template<class F>
+    NodeId addTask(F&& fn, const std::vector<NodeId>& dependencies,
+                   const TaskOptions& options = TaskOptions());
+
+    // Adds an edge: after starts only once before has finished
+    void precede(NodeId before, NodeId after);
+
+    // Posts every node without predecessors and returns immediately.
+    // Throws std::runtime_error if the graph is already running or has a cycle.
+    void run(ThreadPool& pool);
+
+    // Blocks until the current run finishes and rethrows the first exception
+    // thrown by a node. Nodes that had not started when a node failed are
+    // skipped. Must not be called from a node of the same graph.
+    void wait();
+
+    bool isRunning() const { return running_.load(); }
+    size_t size() const { return nodes_.size(); }
+
+private:
+    struct Node {
+        Task work;
+        TaskOptions options;
+        std::vector<NodeId> successors;
+        size_t predecessor_count{0};
+        std::atomic<size_t> pending{0};
+    };
+
+    NodeId addNode(Task work, const NodeId* dependencies, size_t count,
+                   const TaskOptions& options);
+    void checkAcyclic() const;
+    void schedule(NodeId id);
+    void runNode(NodeId id);
+    void finishRun();
+
+    // std::deque keeps node addresses stable while the graph grows
+    std::deque<Node> nodes_;
+    ThreadPool* pool_{nullptr};
+
+    std::atomic<bool> running_{false};
+    std::atomic<bool> failed_{false};
+    std::atomic<size_t> remaining_{0};
+    std::exception_ptr error_;
+
+    std::mutex mutex_;
+    std::condition_variable done_;
+};
+
+template<class F>
+TaskGraph::NodeId TaskGraph::addTask(F&& fn, std::initializer_list<NodeId> dependencies,
+                                     const TaskOptions& options) {
+    return addNode(Task(std::forward<F>(fn)), dependencies.begin(), dependencies.size(), options);
+}
+
+template<class F>
+TaskGraph::NodeId TaskGraph::addTask(F&& fn, const std::vector<NodeId>& dependencies,
+                                     const TaskOptions& options) {
+    return addNode(Task(std::forward<F>(fn)), dependencies.data(), dependencies.size(), options);
+}
+
+} // namespace os_sim
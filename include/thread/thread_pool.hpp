@@ -1,7 +1,16 @@
 // include/thread/thread_pool.hpp
 #pragma once
+#include "thread/block_pool.hpp"
+#include "thread/latency_histogram.hpp"
+#include "thread/mpmc_queue.hpp"
+#include "thread/task.hpp"
+#include "thread/timer_wheel.hpp"
+#include "thread/work_stealing_deque.hpp"
+#include <algorithm>
 #include <vector>
-#include <queue>
+#include <tuple>
+#include <iterator>
+#include <exception>
 #include <thread>
 #include <future>
 #include <functional>
@@ -13,16 +22,157 @@
 
 namespace os_sim {
 
+// How tasks are distributed between workers
+enum class ThreadPoolMode {
+    SHARED_QUEUE,   // Single mutex-protected FIFO shared by all workers
+    WORK_STEALING,  // Per-worker deques, idle workers steal from peers
+    BOUNDED_QUEUE   // Lock-free bounded ring shared by all workers
+};
+
+// What submission does when the BOUNDED_QUEUE ring is full. Submissions
+// from the pool's own workers run the task inline instead, since a worker
+// waiting on its own queue could stall the pool.
+enum class QueueFullPolicy {
+    BLOCK,          // Wait until a worker frees a slot
+    REJECT          // Throw std::runtime_error
+};
+
+// Dispatch lanes, served in this order unless a lower lane has aged
+enum class TaskPriority {
+    INTERACTIVE,    // Latency sensitive, e.g. command handlers
+    NORMAL,         // Default for enqueue/post
+    BACKGROUND      // Bulk simulation work
+};
+
+struct TaskOptions {
+    TaskPriority priority = TaskPriority::NORMAL;
+    // Earliest-deadline-first inside the lane; a default-constructed
+    // time_point means no explicit deadline.
+    std::chrono::steady_clock::time_point deadline{};
+};
+
+struct LaneStats {
+    size_t queued_tasks{0};
+    uint64_t completed_tasks{0};
+    double average_wait_time{0.0};  // milliseconds
+    uint64_t missed_deadlines{0};
+};
+
+// Point-in-time view of pool activity, assembled from per-worker counters
+// without stopping the workers. Latencies are in nanoseconds.
+struct ThreadPoolMetrics {
+    size_t workers{0};
+    size_t active_threads{0};
+    size_t queued_tasks{0};
+    uint64_t completed_tasks{0};
+    uint64_t failed_tasks{0};       // Tasks whose exception was discarded
+    uint64_t dropped_timer_tasks{0}; // Due timer tasks the full or stopped queue refused
+    uint64_t stolen_tasks{0};
+    LatencySummary queue_wait;      // Submission to start of execution
+    LatencySummary execution;       // Time spent running the task
+};
+
+// Worker-to-CPU placement
+enum class AffinityPolicy {
+    NONE,           // Let the OS schedule workers anywhere
+    ROUND_ROBIN,    // Worker i pinned to the i-th usable CPU, filling one NUMA node first
+    CPU_LIST        // Worker i pinned to cpu_list[i % cpu_list.size()]
+};
+
+// Where a worker slot runs, as reported by getWorkerPlacement()
+struct WorkerPlacement {
+    size_t worker{0};
+    int cpu{-1};        // -1 when not pinned
+    int node{0};
+    bool running{false};
+    bool pinned{false}; // Affinity call succeeded
+};
+
+// Elastic pool configuration. The pool starts with min_threads workers (at
+// least one), adds one (up to max_threads) whenever queued work has waited
+// longer than grow_wait_threshold with no idle worker, and retires workers
+// above the minimum after idle_timeout without work. Growth is checked on
+// submit, on dequeue, and every grow_wait_threshold while work is queued,
+// so work queued behind workers that are all blocked still gets one.
+struct ThreadPoolConfig {
+    size_t min_threads = 1;
+    size_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+    ThreadPoolMode mode = ThreadPoolMode::SHARED_QUEUE;
+    std::chrono::milliseconds grow_wait_threshold{5};
+    std::chrono::milliseconds idle_timeout{2000};
+    // Idle workers poll for this long before parking on the condition variable
+    std::chrono::microseconds spin_duration{50};
+    AffinityPolicy affinity = AffinityPolicy::NONE;
+    std::vector<int> cpu_list;  // Used with AffinityPolicy::CPU_LIST
+    // Resolution of scheduleAfter/scheduleEvery
+    std::chrono::milliseconds timer_tick{1};
+    // BOUNDED_QUEUE only; rounded up to a power of two
+    size_t queue_capacity = 4096;
+    QueueFullPolicy queue_full_policy = QueueFullPolicy::BLOCK;
+};
+
+// Returned by scheduleAfter/scheduleEvery; pass to cancelTimer
+struct TimerHandle {
+    uint64_t id{0};
+    explicit operator bool() const { return id != 0; }
+};
+
 class ThreadPool {
 public:
-    explicit ThreadPool(size_t num_threads);
+    // Fixed-size pool
+    explicit ThreadPool(size_t num_threads, ThreadPoolMode mode = ThreadPoolMode::SHARED_QUEUE);
+    // Elastic pool
+    explicit ThreadPool(const ThreadPoolConfig& config);
     ~ThreadPool();
 
     // Task submission
     template<class F, class... Args>
-    auto enqueue(F&& f, Args&&... args) 
+    auto enqueue(F&& f, Args&&... args)
         -> std::future<typename std::result_of<F(Args...)>::type>;
 
+    // Fire-and-forget submission; no future or shared state is created.
+    // Exceptions escaping the task are discarded.
+    template<class F>
+    void post(F&& f);
+
+    // Same as enqueue/post, dispatched through the lane and deadline in options
+    template<class F, class... Args>
+    auto enqueueWithOptions(const TaskOptions& options, F&& f, Args&&... args)
+        -> std::future<typename std::result_of<F(Args...)>::type>;
+    template<class F>
+    void postWithOptions(const TaskOptions& options, F&& f);
+
+    // Bulk submission: every callable in the range is queued under a single
+    // lock acquisition. Returns one future per callable, in range order.
+    template<class Range>
+    auto enqueueBulk(Range&& tasks)
+        -> std::vector<std::future<typename std::result_of<
+               typename std::decay<decltype(*std::begin(tasks))>::type()>::type>>;
+
+    // Data-parallel loops. [begin, end) is split into chunks of `grain`
+    // indices (0 picks a grain from the worker count); the calling thread
+    // executes chunks too and returns once all of them are done. The first
+    // exception thrown by a chunk is rethrown to the caller.
+    template<class F>
+    void parallelFor(size_t begin, size_t end, size_t grain, F&& fn);
+
+    // fn(chunk_begin, chunk_end, identity) folds one chunk; partial results
+    // are combined with reduce in index order, so the result is deterministic.
+    template<class T, class F, class R>
+    T parallelReduce(size_t begin, size_t end, size_t grain, T identity, F&& fn, R&& reduce);
+
+    // Timers. The callable is posted with options once the delay has passed
+    // (rounded up to the timer tick); periodic callables are posted every
+    // period, even if the previous run has not finished yet.
+    template<class F>
+    TimerHandle scheduleAfter(std::chrono::steady_clock::duration delay, F&& f,
+                              const TaskOptions& options = TaskOptions());
+    template<class F>
+    TimerHandle scheduleEvery(std::chrono::steady_clock::duration period, F&& f,
+                              const TaskOptions& options = TaskOptions());
+    // False if the timer already fired (one-shot) or was cancelled
+    bool cancelTimer(TimerHandle handle);
+
     // Pool management
     void shutdown();
     void pause();
@@ -32,59 +182,303 @@ public:
     size_t getActiveThreadCount() const;
     size_t getQueuedTaskCount() const;
     double getAverageWaitTime() const;
+    LaneStats getLaneStats(TaskPriority priority) const;
+    ThreadPoolMetrics getMetrics() const;
+    size_t getWorkerCount() const { return live_workers_.load(); }
+    std::vector<WorkerPlacement> getWorkerPlacement() const;
+    size_t getPendingTimerCount() const;
+    const ThreadPoolConfig& getConfig() const { return config_; }
+    ThreadPoolMode getMode() const { return config_.mode; }
 
 private:
-    std::vector<std::thread> workers_;
-    std::queue<std::function<void()>> tasks_;
+    // Intrusive queue entry carved from BlockPool
+    struct TaskNode;
+
+    // Shared state of one parallelFor/parallelReduce call
+    struct ChunkedJob;
+    using ChunkFunction = void (*)(void* context, size_t chunk, size_t begin, size_t end);
+
+    // Runs a callable and publishes its result through a pooled promise
+    template<class R, class F, class... Args>
+    struct PromiseTask {
+        std::promise<R> promise;
+        F function;
+        std::tuple<Args...> args;
+
+        void operator()() {
+            try {
+                if constexpr (std::is_void<R>::value) {
+                    std::apply(function, args);
+                    promise.set_value();
+                } else {
+                    promise.set_value(std::apply(function, args));
+                }
+            } catch (...) {
+                promise.set_exception(std::current_exception());
+            }
+        }
+    };
+
+    static constexpr size_t kLaneCount = 3;
+
+    // Written only by the worker that owns the slot, so updates are plain
+    // relaxed stores; readers sum over all workers. Cache-line aligned to
+    // keep workers from sharing lines.
+    struct alignas(64) WorkerStats {
+        std::atomic<bool> active{false};
+        std::atomic<uint64_t> completed[kLaneCount] = {};
+        std::atomic<uint64_t> wait_time[kLaneCount] = {};  // nanoseconds
+        std::atomic<uint64_t> missed_deadlines[kLaneCount] = {};
+        std::atomic<uint64_t> failed{0};
+        std::atomic<uint64_t> stolen{0};
+        LatencyHistogram wait_histogram;
+        LatencyHistogram run_histogram;
+    };
+
+    // One slot per potential worker; slots are reused as the pool resizes
+    struct Worker {
+        std::thread thread;
+        bool running{false};  // Guarded by queue_mutex_
+        WorkStealingDeque<TaskNode> deque;
+        uint64_t steal_seed{0};
+        uint32_t tasks_since_shared_check{0};
+        int cpu{-1};
+        int node{0};
+        std::atomic<bool> pinned{false};
+        WorkerStats stats;
+    };
+
+    // Shared-queue lane; FIFO for plain tasks, min-heap for deadline tasks.
+    // Queue members are guarded by queue_mutex_.
+    struct Lane {
+        TaskNode* head{nullptr};
+        TaskNode* tail{nullptr};
+        std::vector<TaskNode*> deadline_heap;
+
+        std::atomic<size_t> size{0};
+    };
+
+    ThreadPoolConfig config_;
+    Lane lanes_[kLaneCount];
+    std::vector<std::unique_ptr<Worker>> workers_;
 
     mutable std::mutex queue_mutex_;
     std::condition_variable condition_;
     std::condition_variable pause_condition_;
 
-    bool stop_;
-    bool paused_;
-    size_t active_threads_;
+    std::atomic<bool> stop_;
+    std::atomic<bool> paused_;
+
+    // Elastic sizing
+    std::atomic<size_t> live_workers_{0};
+    std::atomic<bool> growing_{false};
+    // Re-checks growth while work stays queued; only runs when the pool
+    // can grow. monitor_idle_ is set while it waits for queued work.
+    std::thread monitor_thread_;
+    std::mutex monitor_mutex_;
+    std::condition_variable monitor_condition_;
+    bool monitor_stop_{false};
+    std::atomic<bool> monitor_idle_{false};
+
+    // Plain NORMAL tasks bypass the lanes: BOUNDED_QUEUE mode puts them in
+    // this ring, WORK_STEALING mode in the submitting worker's deque
+    std::unique_ptr<MpmcQueue<TaskNode*>> bounded_queue_;
+    std::condition_variable space_condition_;
+    std::atomic<size_t> blocked_producers_{0};
 
-    // Performance metrics
-    std::atomic<uint64_t> total_tasks_completed_{0};
-    std::atomic<uint64_t> total_wait_time_{0};
+    // Work-stealing bookkeeping; local_queue_size_ counts tasks held in
+    // worker deques or the bounded ring
+    std::atomic<size_t> shared_queue_size_{0};
+    std::atomic<size_t> local_queue_size_{0};
+    std::atomic<size_t> sleeping_workers_{0};
+    std::atomic<size_t> spinning_workers_{0};
 
-    void workerFunction();
+    // Timer service; the thread is started by the first scheduled timer.
+    // Lock order: timer_mutex_ before queue_mutex_.
+    TimerWheel timer_wheel_;
+    std::thread timer_thread_;
+    mutable std::mutex timer_mutex_;
+    std::condition_variable timer_condition_;
+    std::chrono::steady_clock::time_point timer_wakeup_{std::chrono::steady_clock::time_point::max()};
+    bool timer_stop_{false};
+    // Filled by wheel callbacks, posted by timerFunction once it unlocks
+    std::vector<std::pair<Task, TaskOptions>> timer_due_;
+    std::atomic<uint64_t> timer_drops_{0};
+
+    // may_block false makes a full bounded ring throw instead of waiting
+    void submit(Task task, const TaskOptions& options = TaskOptions(), bool may_block = true);
+    void submitBulk(Task* tasks, size_t count);
+    size_t chunkGrain(size_t count, size_t grain) const;
+    void runChunked(size_t begin, size_t end, size_t grain,
+                    ChunkFunction function, void* context);
+    void pushBounded(TaskNode* node, bool may_block = true);
+    TaskNode* popBounded();
+    void pushShared(TaskNode* node);
+    TaskNode* popShared();
+    size_t selectLane(std::chrono::steady_clock::time_point now) const;
+    void assignPlacement();
+    void applyPlacement(size_t index);
+    bool spawnWorker();
+    void maybeGrow(std::chrono::steady_clock::duration observed_wait);
+    void wakeMonitor();
+    void monitorFunction();
+    uint64_t completedTaskCount() const;
+    bool spinForWork();
+    bool hasQueuedWork() const;
+    bool parkWorker(std::unique_lock<std::mutex>& lock, size_t index);
+    void workerFunction(size_t index);
+    void workStealingWorkerFunction(size_t index);
+    TaskNode* findTask(size_t index);
+    TaskNode* stealTask(size_t index);
+    void runTask(size_t index, TaskNode* node);
+    TimerHandle scheduleTimer(std::chrono::steady_clock::time_point when,
+                              std::chrono::steady_clock::duration period, Task task);
+    void timerFunction();
 };
 
 // Template implementation must be in header
 template<class F, class... Args>
-auto ThreadPool::enqueue(F&& f, Args&&... args) 
+auto ThreadPool::enqueue(F&& f, Args&&... args)
+    -> std::future<typename std::result_of<F(Args...)>::type>
+{
+    return enqueueWithOptions(TaskOptions(), std::forward<F>(f), std::forward<Args>(args)...);
+}
+
+template<class F>
+void ThreadPool::post(F&& f) {
+    submit(Task(std::forward<F>(f)));
+}
+
+template<class F, class... Args>
+auto ThreadPool::enqueueWithOptions(const TaskOptions& options, F&& f, Args&&... args)
     -> std::future<typename std::result_of<F(Args...)>::type>
 {
     using return_type = typename std::result_of<F(Args...)>::type;
-    
-    auto task = std::make_shared<std::packaged_task<return_type()>>(
-        std::bind(std::forward<F>(f), std::forward<Args>(args)...)
-    );
-    
-    std::future<return_type> res = task->get_future();
-    
-    {
-        std::unique_lock<std::mutex> lock(queue_mutex_);
-        
-        if (stop_) {
-            throw std::runtime_error("Cannot enqueue on stopped ThreadPool");
+    using task_type = PromiseTask<return_type,
+                                  typename std::decay<F>::type,
+                                  typename std::decay<Args>::type...>;
+
+    // Shared state and result storage come from the block pool
+    std::promise<return_type> promise(std::allocator_arg, PoolAllocator<return_type>());
+    std::future<return_type> res = promise.get_future();
+
+    submit(Task(task_type{std::move(promise),
+                          std::forward<F>(f),
+                          std::forward_as_tuple(std::forward<Args>(args)...)}),
+           options);
+
+    return res;
+}
+
+template<class F>
+void ThreadPool::postWithOptions(const TaskOptions& options, F&& f) {
+    submit(Task(std::forward<F>(f)), options);
+}
+
+template<class Range>
+auto ThreadPool::enqueueBulk(Range&& tasks)
+    -> std::vector<std::future<typename std::result_of<
+           typename std::decay<decltype(*std::begin(tasks))>::type()>::type>>
+{
+    using callable_type = typename std::decay<decltype(*std::begin(tasks))>::type;
+    using return_type = typename std::result_of<callable_type()>::type;
+    using task_type = PromiseTask<return_type, callable_type>;
+    constexpr bool movable = !std::is_lvalue_reference<Range>::value;
+
+    std::vector<Task> batch;
+    std::vector<std::future<return_type>> results;
+    batch.reserve(std::distance(std::begin(tasks), std::end(tasks)));
+    results.reserve(batch.capacity());
+
+    for (auto& callable : tasks) {
+        std::promise<return_type> promise(std::allocator_arg, PoolAllocator<return_type>());
+        results.push_back(promise.get_future());
+        if constexpr (movable) {
+            batch.emplace_back(task_type{std::move(promise), std::move(callable), {}});
+        } else {
+            batch.emplace_back(task_type{std::move(promise), callable, {}});
         }
-        
-        auto enqueue_time = std::chrono::steady_clock::now();
-        
-        tasks_.emplace([task, this, enqueue_time]() {
-            auto start_time = std::chrono::steady_clock::now();
-            auto wait_time = std::chrono::duration_cast<std::chrono::milliseconds>(
-                start_time - enqueue_time).count();
-            total_wait_time_ += wait_time;
-            (*task)();
-        });
     }
-    
-    condition_.notify_one();
-    return res;
+
+    submitBulk(batch.data(), batch.size());
+    return results;
+}
+
+template<class F>
+void ThreadPool::parallelFor(size_t begin, size_t end, size_t grain, F&& fn) {
+    using function_type = typename std::remove_reference<F>::type;
+
+    runChunked(begin, end, grain,
+        [](void* context, size_t, size_t first, size_t last) {
+            auto& function = *static_cast<function_type*>(context);
+            for (size_t i = first; i < last; ++i) {
+                function(i);
+            }
+        },
+        const_cast<void*>(static_cast<const void*>(std::addressof(fn))));
+}
+
+template<class T, class F, class R>
+T ThreadPool::parallelReduce(size_t begin, size_t end, size_t grain,
+                             T identity, F&& fn, R&& reduce)
+{
+    if (begin >= end) {
+        return identity;
+    }
+
+    // Wrapped so that T = bool does not hit the packed vector<bool>
+    struct Partial { T value; };
+
+    size_t chunk_grain = chunkGrain(end - begin, grain);
+    size_t chunk_count = (end - begin + chunk_grain - 1) / chunk_grain;
+    std::vector<Partial> partials(chunk_count, Partial{identity});
+
+    struct Context {
+        typename std::remove_reference<F>::type* function;
+        std::vector<Partial>* partials;
+        const T* identity;
+    } context{std::addressof(fn), &partials, &identity};
+
+    runChunked(begin, end, chunk_grain,
+        [](void* raw, size_t chunk, size_t first, size_t last) {
+            auto& ctx = *static_cast<Context*>(raw);
+            (*ctx.partials)[chunk].value = (*ctx.function)(first, last, *ctx.identity);
+        },
+        &context);
+
+    T result = std::move(partials[0].value);
+    for (size_t i = 1; i < chunk_count; ++i) {
+        result = reduce(std::move(result), std::move(partials[i].value));
+    }
+    return result;
+}
+
+template<class F>
+TimerHandle ThreadPool::scheduleAfter(std::chrono::steady_clock::duration delay, F&& f,
+                                      const TaskOptions& options) {
+    using callable_type = typename std::decay<F>::type;
+
+    // Runs on the timer thread and only queues the callable for posting
+    return scheduleTimer(std::chrono::steady_clock::now() + delay,
+                         std::chrono::steady_clock::duration::zero(),
+                         Task([this, options, function = callable_type(std::forward<F>(f))]() mutable {
+                             timer_due_.emplace_back(Task(std::move(function)), options);
+                         }));
+}
+
+template<class F>
+TimerHandle ThreadPool::scheduleEvery(std::chrono::steady_clock::duration period, F&& f,
+                                      const TaskOptions& options) {
+    using callable_type = typename std::decay<F>::type;
+
+    // Shared so that every firing posts the same callable without copying it
+    auto function = std::allocate_shared<callable_type>(PoolAllocator<callable_type>(),
+                                                        std::forward<F>(f));
+    return scheduleTimer(std::chrono::steady_clock::now() + period, period,
+                         Task([this, options, function]() {
+                             timer_due_.emplace_back(Task([function]() { (*function)(); }),
+                                                     options);
+                         }));
 }
 
-} // namespace os_sim
\ No newline at end of file
+} // namespace os_sim
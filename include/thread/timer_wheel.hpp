@@ -0,0 +1,91 @@
+// include/thread/timer_wheel.hpp
+#pragma once
+#include "thread/task.hpp"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace os_sim {
+
+// Hierarchical timing wheel: kLevels wheels of kSlots slots, each level
+// kSlots times coarser than the one below. Timers live in intrusive lists
+// inside a slab, so schedule and cancel are O(1); advance() costs one step
+// per occupied slot plus one per kSlots ticks. Not thread-safe: the owner
+// serializes access (ThreadPool does so with its timer mutex).
+class TimerWheel {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr size_t kSlotBits = 6;
+    static constexpr size_t kSlots = size_t(1) << kSlotBits;
+    static constexpr size_t kLevels = 6;
+    // Delays past this many ticks are clamped (~2 years at 1 ms)
+    static constexpr uint64_t kMaxTicks = (uint64_t(1) << (kSlotBits * kLevels)) - 1;
+
+    explicit TimerWheel(Clock::duration tick = std::chrono::milliseconds(1),
+                        Clock::time_point origin = Clock::now());
+
+    // Runs task at (or up to one tick after) when, then every period if the
+    // period is non-zero. Returns a non-zero id for cancel().
+    uint64_t schedule(Clock::time_point when, Task task,
+                      Clock::duration period = Clock::duration::zero());
+
+    // False if the timer already fired (one-shot) or was cancelled
+    bool cancel(uint64_t id);
+
+    // Fires every timer due at or before now, in expiry order. Callbacks run
+    // inline and must not call back into the wheel; exceptions they throw
+    // are discarded. Returns the number of callbacks run.
+    size_t advance(Clock::time_point now);
+
+    // Earliest time at which advance() may have work to do; time_point::max()
+    // when no timers are pending.
+    Clock::time_point nextWakeup() const;
+
+    size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+    Clock::duration getTick() const { return tick_; }
+
+private:
+    static constexpr uint32_t kNone = UINT32_MAX;
+    // Entries live in fixed-size chunks so growing never relocates them
+    static constexpr size_t kChunkBits = 12;
+    static constexpr size_t kChunkSize = size_t(1) << kChunkBits;
+
+    struct Entry {
+        Task task;
+        uint64_t expiry{0};     // Absolute tick
+        uint64_t period{0};     // Ticks; 0 for one-shot
+        uint32_t prev{kNone};
+        uint32_t next{kNone};
+        uint32_t generation{1};
+        uint16_t bucket{0};     // level * kSlots + slot
+        bool armed{false};
+    };
+
+    Entry& entry(uint32_t index) {
+        return chunks_[index >> kChunkBits][index & (kChunkSize - 1)];
+    }
+
+    uint64_t toTick(Clock::time_point when) const;
+    void link(uint32_t index);
+    void unlink(uint32_t index);
+    void release(uint32_t index);
+    void cascade(size_t level);
+    size_t fireSlot(size_t slot);
+    uint64_t nextEventTick() const;
+
+    Clock::duration tick_;
+    Clock::time_point origin_;
+    uint64_t current_{0};   // Last processed tick
+    size_t count_{0};
+
+    std::vector<std::unique_ptr<Entry[]>> chunks_;
+    uint32_t entry_count_{0};  // Slots handed out so far, live or free
+    uint32_t free_head_{kNone};
+    uint32_t heads_[kLevels * kSlots];
+    uint64_t occupied_[kLevels] = {};  // Bit per non-empty slot
+};
+
+} // namespace os_sim
@@ -0,0 +1,145 @@
+// include/thread/work_stealing_deque.hpp
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace os_sim {
+
+// Chase-Lev work-stealing deque. The owning worker pushes and pops at the
+// bottom; any other thread may steal from the top. Elements are raw pointers,
+// ownership stays with the caller.
+template<typename T>
+class WorkStealingDeque {
+public:
+    explicit WorkStealingDeque(size_t initial_capacity = 256)
+        : top_(0)
+        , bottom_(0)
+    {
+        size_t capacity = 1;
+        while (capacity < initial_capacity) {
+            capacity <<= 1;
+        }
+        arrays_.push_back(std::make_unique<Array>(capacity));
+        array_.store(arrays_.back().get(), std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    // Owner only
+    void push(T* item) {
+        int64_t b = bottom_.load(std::memory_order_relaxed);
+        int64_t t = top_.load(std::memory_order_acquire);
+        Array* a = array_.load(std::memory_order_relaxed);
+
+        if (b - t > static_cast<int64_t>(a->capacity()) - 1) {
+            a = grow(a, b, t);
+        }
+
+        a->put(b, item);
+        bottom_.store(b + 1, std::memory_order_release);
+    }
+
+    // Owner only
+    T* pop() {
+        int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+        Array* a = array_.load(std::memory_order_relaxed);
+        bottom_.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top_.load(std::memory_order_relaxed);
+
+        if (t > b) {
+            // Deque was empty
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        T* item = a->get(b);
+        if (t == b) {
+            // Last element, race against thieves for it
+            if (!top_.compare_exchange_strong(t, t + 1,
+                                              std::memory_order_seq_cst,
+                                              std::memory_order_relaxed)) {
+                item = nullptr;
+            }
+            bottom_.store(b + 1, std::memory_order_relaxed);
+        }
+        return item;
+    }
+
+    // Any thread
+    T* steal() {
+        int64_t t = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = bottom_.load(std::memory_order_acquire);
+
+        if (t >= b) {
+            return nullptr;
+        }
+
+        Array* a = array_.load(std::memory_order_acquire);
+        T* item = a->get(t);
+        if (!top_.compare_exchange_strong(t, t + 1,
+                                          std::memory_order_seq_cst,
+                                          std::memory_order_relaxed)) {
+            return nullptr;  // Lost the race to another thief or the owner
+        }
+        return item;
+    }
+
+    // Approximate when called concurrently
+    size_t size() const {
+        int64_t b = bottom_.load(std::memory_order_relaxed);
+        int64_t t = top_.load(std::memory_order_relaxed);
+        return b > t ? static_cast<size_t>(b - t) : 0;
+    }
+
+    bool empty() const { return size() == 0; }
+
+private:
+    class Array {
+    public:
+        explicit Array(size_t capacity)
+            : mask_(capacity - 1)
+            , slots_(new std::atomic<T*>[capacity])
+        {}
+
+        size_t capacity() const { return mask_ + 1; }
+
+        T* get(int64_t index) const {
+            return slots_[static_cast<size_t>(index) & mask_].load(std::memory_order_relaxed);
+        }
+
+        void put(int64_t index, T* item) {
+            slots_[static_cast<size_t>(index) & mask_].store(item, std::memory_order_relaxed);
+        }
+
+    private:
+        size_t mask_;
+        std::unique_ptr<std::atomic<T*>[]> slots_;
+    };
+
+    Array* grow(Array* old_array, int64_t bottom, int64_t top) {
+        auto bigger = std::make_unique<Array>(old_array->capacity() * 2);
+        for (int64_t i = top; i < bottom; ++i) {
+            bigger->put(i, old_array->get(i));
+        }
+
+        // Thieves may still be reading the old array, so it is retired
+        // rather than freed until the deque itself goes away.
+        Array* raw = bigger.get();
+        arrays_.push_back(std::move(bigger));
+        array_.store(raw, std::memory_order_release);
+        return raw;
+    }
+
+    alignas(64) std::atomic<int64_t> top_;
+    alignas(64) std::atomic<int64_t> bottom_;
+    std::atomic<Array*> array_;
+    std::vector<std::unique_ptr<Array>> arrays_;  // Owner only
+};
+
+} // namespace os_sim
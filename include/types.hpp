@@ -38,12 +38,28 @@ enum class ResourceType {
     GENERIC
 };
 
-// Process statistics structure
+constexpr size_t kResourceTypeCount = static_cast<size_t>(ResourceType::GENERIC) + 1;
+
+// Process statistics structure. Times are in nanoseconds and charged when
+// the process leaves a state, so time in the current state is not included.
 struct ProcessStats {
-    uint64_t cpu_time{0};         // CPU time used
+    uint64_t cpu_time{0};         // Time RUNNING (user time; there is no kernel mode)
+    uint64_t ready_time{0};       // Time READY, waiting for a CPU
+    uint64_t wait_time{0};        // Time WAITING
     uint64_t memory_used{0};      // Memory currently allocated
     uint64_t io_operations{0};    // Number of I/O operations
-    uint64_t context_switches{0}; // Number of context switches
+    uint64_t context_switches{0}; // Number of state transitions
+};
+
+// Per simulated CPU counters
+struct CpuStats {
+    uint64_t busy_ticks{0};       // Ticks spent running a process
+    uint64_t idle_ticks{0};       // Ticks with nothing to run
+    uint64_t dispatches{0};       // Processes started on this CPU
+    uint64_t migrations_in{0};    // READY processes pulled from other CPUs
+    uint64_t migrations_out{0};   // READY processes pulled away
+    size_t ready{0};              // Run queue length
+    ProcessID running{-1};        // -1 when idle
 };
 
 // String conversion functions
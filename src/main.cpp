@@ -1,10 +1,53 @@
 // src/main.cpp
 #include "simulator.hpp"
+#include "thread/cpu_topology.hpp"
+#include <cstdlib>
 #include <iostream>
+#include <string>
 
-int main() {
+namespace {
+
+void printUsage(const char* program) {
+    std::cerr << "Usage: " << program
+              << " [--affinity=none|round-robin] [--cpus=<list>] [--smp=<n>]\n"
+              << "  --affinity=round-robin  Pin pool workers to CPUs, one NUMA node at a time\n"
+              << "  --cpus=0-3,8            Pin pool workers to the listed CPUs\n"
+              << "  --smp=4                 Number of simulated CPUs (default 1)\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
     try {
         auto& simulator = os_sim::Simulator::getInstance();
+
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--affinity=none") {
+                simulator.setWorkerAffinity(os_sim::AffinityPolicy::NONE);
+            } else if (arg == "--affinity=round-robin") {
+                simulator.setWorkerAffinity(os_sim::AffinityPolicy::ROUND_ROBIN);
+            } else if (arg.rfind("--cpus=", 0) == 0) {
+                auto cpus = os_sim::CpuTopology::parseCpuList(arg.substr(7));
+                if (cpus.empty()) {
+                    printUsage(argv[0]);
+                    return 1;
+                }
+                simulator.setWorkerAffinity(os_sim::AffinityPolicy::CPU_LIST, cpus);
+            } else if (arg.rfind("--smp=", 0) == 0) {
+                char* end = nullptr;
+                unsigned long count = std::strtoul(arg.c_str() + 6, &end, 10);
+                if (count == 0 || count > 1024 || *end != '\0') {
+                    printUsage(argv[0]);
+                    return 1;
+                }
+                simulator.setSimulatedCpus(count);
+            } else {
+                printUsage(argv[0]);
+                return 1;
+            }
+        }
+
         simulator.initialize();
         simulator.run();
     } catch (const std::exception& e) {
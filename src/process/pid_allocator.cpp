@@ -0,0 +1,156 @@
+// src/process/pid_allocator.cpp
+#include "process/pid_allocator.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace os_sim {
+
+namespace {
+
+uint64_t bit(size_t index) {
+    return uint64_t{1} << (index % 64);
+}
+
+} // namespace
+
+PidAllocator::PidAllocator(ProcessID limit, size_t reuse_delay)
+    : limit_(limit)
+    , reuse_delay_(reuse_delay)
+{
+    if (limit <= 0) {
+        throw std::invalid_argument("pid limit must be positive");
+    }
+
+    // Every pid below the limit starts free, and so does every child word
+    size_t entries = static_cast<size_t>(limit);
+    do {
+        size_t words = (entries + kWordBits - 1) / kWordBits;
+        Level level(new std::atomic<uint64_t>[words]);
+        for (size_t word = 0; word < words; ++word) {
+            size_t used = std::min(kWordBits, entries - word * kWordBits);
+            level[word].store(used == kWordBits ? ~uint64_t{0} : (uint64_t{1} << used) - 1,
+                              std::memory_order_relaxed);
+        }
+        levels_.push_back(std::move(level));
+        entries = words;
+    } while (entries > 1);
+
+    if (reuse_delay_ > 0) {
+        delayed_.reset(new std::atomic<ProcessID>[reuse_delay_]);
+        for (size_t slot = 0; slot < reuse_delay_; ++slot) {
+            delayed_[slot].store(-1, std::memory_order_relaxed);
+        }
+    }
+}
+
+ProcessID PidAllocator::allocate() {
+    ProcessID pid = -1;
+    if (claim(levels_.size() - 1, 0, &pid, 1) == 0) {
+        return -1;
+    }
+    in_use_.fetch_add(1, std::memory_order_relaxed);
+    return pid;
+}
+
+bool PidAllocator::allocate(size_t count, std::vector<ProcessID>& pids) {
+    size_t first = pids.size();
+    pids.resize(first + count);
+    size_t claimed = count ? claim(levels_.size() - 1, 0, pids.data() + first, count) : 0;
+
+    if (claimed < count) {
+        // Never seen by anyone, so no reuse delay
+        for (size_t i = first; i < first + claimed; ++i) {
+            release(pids[i]);
+        }
+        pids.resize(first);
+        return false;
+    }
+    in_use_.fetch_add(count, std::memory_order_relaxed);
+    return true;
+}
+
+void PidAllocator::free(ProcessID pid) {
+    in_use_.fetch_sub(1, std::memory_order_relaxed);
+    if (reuse_delay_ == 0) {
+        release(pid);
+        return;
+    }
+
+    // Whatever pid this slot held has now waited reuse_delay frees
+    size_t slot = delayed_cursor_.fetch_add(1, std::memory_order_relaxed) % reuse_delay_;
+    ProcessID expired = delayed_[slot].exchange(pid, std::memory_order_acq_rel);
+    if (expired >= 0) {
+        release(expired);
+    }
+}
+
+size_t PidAllocator::claim(size_t level, size_t index, ProcessID* out, size_t count) {
+    auto& word = levels_[level][index];
+    uint64_t bits = word.load(std::memory_order_acquire);
+
+    // Lowest set bits first; inner bits are only hints, so a child that
+    // comes up short is marked full and the next bit is tried
+    size_t claimed = 0;
+    while (bits && claimed < count) {
+        if (level == 0) {
+            // Take as many of this word's free pids as are still wanted in
+            // one exchange
+            uint64_t taken = 0;
+            uint64_t rest = bits;
+            for (size_t n = claimed; n < count && rest; ++n) {
+                taken |= rest & (~rest + 1);
+                rest &= rest - 1;
+            }
+            if (!word.compare_exchange_weak(bits, rest, std::memory_order_acq_rel)) {
+                continue;
+            }
+            if (rest == 0 && levels_.size() > 1) {
+                markFull(1, index);
+            }
+            for (; taken; taken &= taken - 1) {
+                size_t offset = static_cast<size_t>(__builtin_ctzll(taken));
+                out[claimed++] = static_cast<ProcessID>(index * kWordBits + offset);
+            }
+            return claimed;
+        }
+
+        size_t offset = static_cast<size_t>(__builtin_ctzll(bits));
+        size_t child = index * kWordBits + offset;
+        size_t wanted = count - claimed;
+        size_t got = claim(level - 1, child, out + claimed, wanted);
+        claimed += got;
+        if (got < wanted) {
+            markFull(level, child);
+        }
+        bits &= ~bit(offset);
+    }
+    return claimed;
+}
+
+void PidAllocator::release(ProcessID pid) {
+    auto child = static_cast<size_t>(pid);
+    levels_[0][child / kWordBits].fetch_or(bit(child), std::memory_order_acq_rel);
+    markFree(1, child / kWordBits);
+}
+
+void PidAllocator::markFull(size_t level, size_t child) {
+    // child, a word of the level below, looked empty. Clear its hint, then
+    // look again: a free that raced in must not stay hidden.
+    auto& word = levels_[level][child / kWordBits];
+    uint64_t previous = word.fetch_and(~bit(child), std::memory_order_acq_rel);
+
+    if (levels_[level - 1][child].load(std::memory_order_acquire) != 0) {
+        markFree(level, child);
+    } else if (previous == bit(child) && level + 1 < levels_.size()) {
+        markFull(level + 1, child / kWordBits);
+    }
+}
+
+void PidAllocator::markFree(size_t level, size_t child) {
+    for (; level < levels_.size(); ++level) {
+        levels_[level][child / kWordBits].fetch_or(bit(child), std::memory_order_acq_rel);
+        child /= kWordBits;
+    }
+}
+
+} // namespace os_sim
@@ -1,21 +1,53 @@
 // src/process/process.cpp
 #include "process/process.hpp"
 #include "resource/resource_manager.hpp"
+#include "thread/cycle_clock.hpp"
 #include <algorithm>
-#include <chrono>
 
 namespace os_sim {
 
+namespace {
+
+constexpr size_t kStateCount = static_cast<size_t>(ProcessState::TERMINATED) + 1;
+
+constexpr uint32_t transition(ProcessState from, ProcessState to) {
+    return uint32_t{1} << (static_cast<size_t>(from) * kStateCount + static_cast<size_t>(to));
+}
+
+// Bit from * kStateCount + to is set for each allowed transition
+constexpr uint32_t kTransitions =
+    transition(ProcessState::NEW, ProcessState::READY) |
+    transition(ProcessState::READY, ProcessState::RUNNING) |
+    transition(ProcessState::READY, ProcessState::WAITING) |
+    transition(ProcessState::READY, ProcessState::TERMINATED) |
+    transition(ProcessState::RUNNING, ProcessState::READY) |
+    transition(ProcessState::RUNNING, ProcessState::WAITING) |
+    transition(ProcessState::RUNNING, ProcessState::TERMINATED) |
+    transition(ProcessState::WAITING, ProcessState::READY) |
+    transition(ProcessState::WAITING, ProcessState::TERMINATED);
+static_assert(kStateCount * kStateCount <= 32, "transition table must fit in 32 bits");
+
+constexpr bool canTransition(ProcessState from, ProcessState to) {
+    return (kTransitions & transition(from, to)) != 0;
+}
+
+} // namespace
+
 Process::Process(ProcessID pid, std::string name, Priority priority)
     : pid_(pid)
-    , name_(std::move(name))
     , state_(ProcessState::NEW)
     , priority_(priority)
+    , state_since_(CycleClock::now())
+    , name_(std::move(name))
 {
     updateStats();
 }
 
 Process::~Process() {
+    // Nothing can reach the process now, but its observer may already be
+    // gone during shutdown
+    observer_ = nullptr;
+
     // Release all resources
     auto resources = getAllocatedResources();
     for (const auto& resource_id : resources) {
@@ -23,38 +55,122 @@ Process::~Process() {
     }
 }
 
-ProcessState Process::getState() const {
+void Process::setState(ProcessState new_state) {
     std::lock_guard<std::mutex> lock(process_mutex_);
-    return state_;
+    ProcessState old_state = state_.load(std::memory_order_relaxed);
+
+    if (!canTransition(old_state, new_state)) {
+        throw std::runtime_error("Invalid state transition from " + 
+                               std::to_string(static_cast<int>(old_state)) + 
+                               " to " + std::to_string(static_cast<int>(new_state)));
+    }
+    
+    applyState(old_state, new_state);
 }
 
-Priority Process::getPriority() const {
+bool Process::compareAndSetState(ProcessState expected, ProcessState desired) {
+    // Failures need no lock: the scheduler retries picks and the balancer
+    // probes processes that have usually moved on
+    if (!canTransition(expected, desired) ||
+        state_.load(std::memory_order_acquire) != expected) {
+        return false;
+    }
+
     std::lock_guard<std::mutex> lock(process_mutex_);
-    return priority_;
+    if (state_.load(std::memory_order_relaxed) != expected) {
+        return false;
+    }
+
+    applyState(expected, desired);
+    return true;
 }
 
-void Process::setState(ProcessState new_state) {
-    std::lock_guard<std::mutex> lock(process_mutex_);
-    
-    if (!canTransitionTo(new_state)) {
-        throw std::runtime_error("Invalid state transition from " + 
-                               std::to_string(static_cast<int>(state_)) + 
-                               " to " + std::to_string(static_cast<int>(new_state)));
+bool Process::waitForState(ProcessState state, std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(process_mutex_);
+    ++waiters_;
+    bool reached = state_cv_.wait_for(lock, timeout, [this, state] {
+        return state_.load(std::memory_order_relaxed) == state;
+    });
+    --waiters_;
+    return reached;
+}
+
+void Process::applyState(ProcessState old_state, ProcessState new_state) {
+    // Caller holds process_mutex_ and has validated the transition, which
+    // never leaves the state unchanged
+    state_.store(new_state, std::memory_order_release);
+
+    ProcessStats old_stats = stats_;
+    stats_.context_switches++;
+    chargeState(old_state);
+    reportStats(old_stats);
+    if (observer_) {
+        observer_->onStateChanged(pid_, priority_.load(std::memory_order_relaxed), cpu_,
+                                  old_state, new_state);
     }
-    
-    ProcessState old_state = state_;
-    state_ = new_state;
-    
-    if (old_state != new_state) {
-        stats_.context_switches++;
-        updateStats();
+    if (waiters_ > 0) {
         state_cv_.notify_all();
     }
+    if (new_state == ProcessState::TERMINATED && pending_resource_ >= 0) {
+        ResourceManager::getInstance().cancelWait(pid_);
+    }
+}
+
+ProcessStats Process::getStats() const {
+    std::lock_guard<std::mutex> lock(process_mutex_);
+    return stats_;
+}
+
+void Process::appendTo(ProcessSnapshot& snapshot) const {
+    std::lock_guard<std::mutex> lock(process_mutex_);
+    snapshot.pids.push_back(pid_);
+    snapshot.names.push_back(name_);
+    snapshot.priorities.push_back(priority_.load(std::memory_order_relaxed));
+    snapshot.states.push_back(state_.load(std::memory_order_relaxed));
+    snapshot.cpus.push_back(cpu_);
+    snapshot.stats.push_back(stats_);
+    snapshot.resources.insert(snapshot.resources.end(),
+                              allocated_resources_.begin(), allocated_resources_.end());
+    snapshot.resource_offsets.push_back(snapshot.resources.size());
+}
+
+ProcessStats Process::detachObserver() {
+    std::lock_guard<std::mutex> lock(process_mutex_);
+    observer_ = nullptr;
+    return stats_;
+}
+
+size_t Process::getCpu() const {
+    std::lock_guard<std::mutex> lock(process_mutex_);
+    return cpu_;
+}
+
+bool Process::migrate(size_t from_cpu, size_t to_cpu) {
+    if (from_cpu == to_cpu || state_.load(std::memory_order_acquire) != ProcessState::READY) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(process_mutex_);
+    if (state_.load(std::memory_order_relaxed) != ProcessState::READY || cpu_ != from_cpu) {
+        return false;
+    }
+
+    Priority priority = priority_.load(std::memory_order_relaxed);
+    if (observer_ && !observer_->onMigrated(pid_, priority, from_cpu, to_cpu)) {
+        return false;
+    }
+    cpu_ = to_cpu;
+    return true;
 }
 
 void Process::setPriority(Priority new_priority) {
     std::lock_guard<std::mutex> lock(process_mutex_);
-    priority_ = new_priority;
+    Priority old_priority = priority_.exchange(new_priority, std::memory_order_release);
+
+    if (observer_ && old_priority != new_priority) {
+        observer_->onPriorityChanged(pid_, state_.load(std::memory_order_relaxed), cpu_,
+                                     old_priority, new_priority);
+    }
 }
 
 ErrorCode Process::requestResource(ResourceID resource_id) {
@@ -64,17 +180,64 @@ ErrorCode Process::requestResource(ResourceID resource_id) {
     auto result = rm.allocateResource(pid_, resource_id);
     
     if (result == ErrorCode::SUCCESS) {
-        allocated_resources_.push_back(resource_id);
-        updateStats();
+        addResource(resource_id);
     }
     
     return result;
 }
 
+ErrorCode Process::acquireResource(ResourceID resource_id, std::chrono::milliseconds timeout) {
+    auto& rm = ResourceManager::getInstance();
+    std::unique_lock<std::mutex> lock(process_mutex_);
+    ProcessState state = state_.load(std::memory_order_relaxed);
+    if (state == ProcessState::TERMINATED || pending_resource_ >= 0) {
+        return ErrorCode::INVALID_STATE;
+    }
+    if (std::find(allocated_resources_.begin(), allocated_resources_.end(),
+                  resource_id) != allocated_resources_.end()) {
+        return ErrorCode::OPERATION_FAILED;
+    }
+    if (rm.allocateResource(pid_, resource_id) == ErrorCode::SUCCESS) {
+        addResource(resource_id);
+        return ErrorCode::SUCCESS;
+    }
+
+    pending_resource_ = resource_id;
+    bool parked = state == ProcessState::READY || state == ProcessState::RUNNING;
+    if (parked) {
+        applyState(state, ProcessState::WAITING);
+    }
+
+    // Queued before process_mutex_ is dropped, so a termination from here
+    // on finds the wait to cancel; the scheduler and monitors keep going
+    // while it blocks
+    ErrorCode result = rm.acquireResource(pid_, resource_id, timeout, &lock);
+
+    lock.lock();
+    pending_resource_ = -1;
+    state = state_.load(std::memory_order_relaxed);
+    if (result == ErrorCode::SUCCESS) {
+        if (state == ProcessState::TERMINATED) {
+            // Handed over as it ended; its resources may already be back
+            rm.releaseResource(pid_, resource_id);
+            return ErrorCode::INVALID_STATE;
+        }
+        addResource(resource_id);
+    }
+    if (parked && state == ProcessState::WAITING) {
+        applyState(state, ProcessState::READY);
+    }
+    return result;
+}
+
 ErrorCode Process::releaseResource(ResourceID resource_id) {
     std::lock_guard<std::mutex> lock(process_mutex_);
     
-    if (!hasResource(resource_id)) {
+    // Not hasResource(): it takes process_mutex_ again
+    auto it = std::find(allocated_resources_.begin(), 
+                       allocated_resources_.end(), 
+                       resource_id);
+    if (it == allocated_resources_.end()) {
         return ErrorCode::RESOURCE_NOT_FOUND;
     }
     
@@ -82,13 +245,13 @@ ErrorCode Process::releaseResource(ResourceID resource_id) {
     auto result = rm.releaseResource(pid_, resource_id);
     
     if (result == ErrorCode::SUCCESS) {
-        auto it = std::find(allocated_resources_.begin(), 
-                           allocated_resources_.end(), 
-                           resource_id);
-        if (it != allocated_resources_.end()) {
-            allocated_resources_.erase(it);
-        }
+        ProcessStats old_stats = stats_;
+        allocated_resources_.erase(it);
         updateStats();
+        reportStats(old_stats);
+        if (observer_) {
+            observer_->onResourceChanged(pid_, resource_id, false);
+        }
     }
     
     return result;
@@ -118,42 +281,46 @@ void Process::terminate() {
     setState(ProcessState::TERMINATED);
 }
 
-void Process::updateStats() {
+void Process::chargeState(ProcessState state) {
+    // Closes the interval spent in state. TSC readings from different
+    // cores can be a little apart, so a short interval may come out behind.
+    uint64_t now = CycleClock::now();
+    uint64_t elapsed = now > state_since_ ? now - state_since_ : 0;
+    state_since_ = now;
 
-    stats_.context_switches++;
-    
+    switch (state) {
+        case ProcessState::RUNNING:
+            stats_.cpu_time += elapsed;
+            break;
+        case ProcessState::READY:
+            stats_.ready_time += elapsed;
+            break;
+        case ProcessState::WAITING:
+            stats_.wait_time += elapsed;
+            break;
+        default:
+            break;
+    }
+}
 
-    if (state_ == ProcessState::RUNNING) {
-        static auto last_update = std::chrono::steady_clock::now();
-        auto now = std::chrono::steady_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>
-                       (now - last_update);
-        stats_.cpu_time += duration.count();
-        last_update = now;
+void Process::addResource(ResourceID resource_id) {
+    ProcessStats old_stats = stats_;
+    allocated_resources_.push_back(resource_id);
+    updateStats();
+    reportStats(old_stats);
+    if (observer_) {
+        observer_->onResourceChanged(pid_, resource_id, true);
     }
-    
+}
+
+void Process::updateStats() {
+    // Time and transitions are counted by applyState
     stats_.memory_used = allocated_resources_.size() * 1024;
 }
 
-bool Process::canTransitionTo(ProcessState new_state) const {
-    switch (state_) {
-        case ProcessState::NEW:
-            return new_state == ProcessState::READY;
-        case ProcessState::READY:
-            return new_state == ProcessState::RUNNING || 
-                   new_state == ProcessState::WAITING ||
-                   new_state == ProcessState::TERMINATED;  
-        case ProcessState::RUNNING:
-            return new_state == ProcessState::READY || 
-                   new_state == ProcessState::WAITING || 
-                   new_state == ProcessState::TERMINATED;
-        case ProcessState::WAITING:
-            return new_state == ProcessState::READY ||
-                   new_state == ProcessState::TERMINATED;  
-        case ProcessState::TERMINATED:
-            return false;
-        default:
-            return false;
+void Process::reportStats(const ProcessStats& old_stats) {
+    if (observer_) {
+        observer_->onStatsChanged(pid_, cpu_, old_stats, stats_);
     }
 }
 
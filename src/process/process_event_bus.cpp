@@ -0,0 +1,101 @@
+// src/process/process_event_bus.cpp
+#include "process/process_event_bus.hpp"
+#include "thread/cycle_clock.hpp"
+#include <thread>
+
+namespace os_sim {
+
+SubscriberID ProcessEventBus::subscribe(uint32_t types, size_t capacity) {
+    std::lock_guard<std::mutex> lock(subscribe_mutex_);
+    if (~used_ == 0) {
+        return -1;
+    }
+
+    auto id = static_cast<SubscriberID>(__builtin_ctzll(~used_));
+    Subscriber& subscriber = subscribers_[id];
+    subscriber.ring = std::make_unique<MpmcQueue<ProcessEvent>>(capacity);
+    subscriber.dropped.store(0, std::memory_order_relaxed);
+    subscriber.generation.store(generation_.fetch_add(1, std::memory_order_seq_cst) + 1,
+                                std::memory_order_seq_cst);
+    used_ |= uint64_t{1} << id;
+
+    for (size_t type = 0; type < kProcessEventTypeCount; ++type) {
+        if (types & (uint32_t{1} << type)) {
+            interested_[type].fetch_or(uint64_t{1} << id, std::memory_order_seq_cst);
+        }
+    }
+    return id;
+}
+
+void ProcessEventBus::unsubscribe(SubscriberID id) {
+    std::lock_guard<std::mutex> lock(subscribe_mutex_);
+    if (!valid(id)) {
+        return;
+    }
+
+    // Pairs with publish(): a publisher either sees the bit cleared on its
+    // second look, or is counted in publishers before we check it
+    for (auto& mask : interested_) {
+        mask.fetch_and(~(uint64_t{1} << id), std::memory_order_seq_cst);
+    }
+    Subscriber& subscriber = subscribers_[id];
+    while (subscriber.publishers.load(std::memory_order_seq_cst) != 0) {
+        std::this_thread::yield();
+    }
+    subscriber.ring.reset();
+    used_ &= ~(uint64_t{1} << id);
+}
+
+size_t ProcessEventBus::poll(SubscriberID id, std::vector<ProcessEvent>& out, size_t max) {
+    if (!valid(id)) {
+        return 0;
+    }
+
+    MpmcQueue<ProcessEvent>& ring = *subscribers_[id].ring;
+    size_t count = 0;
+    ProcessEvent event;
+    while (count < max && ring.tryPop(event)) {
+        out.push_back(event);
+        ++count;
+    }
+    return count;
+}
+
+uint64_t ProcessEventBus::dropped(SubscriberID id) const {
+    return valid(id) ? subscribers_[id].dropped.load(std::memory_order_relaxed) : 0;
+}
+
+void ProcessEventBus::publish(ProcessEvent event) {
+    // A slot subscribed after this load may reuse a bit of the mask below;
+    // its generation is newer, so it does not get the event
+    uint64_t generation = generation_.load(std::memory_order_acquire);
+    auto& mask = interested_[index(event.type)];
+    uint64_t interested = mask.load(std::memory_order_acquire);
+    if (interested == 0) {
+        return;
+    }
+
+    event.time = CycleClock::now();
+    for (; interested; interested &= interested - 1) {
+        size_t id = static_cast<size_t>(__builtin_ctzll(interested));
+        Subscriber& subscriber = subscribers_[id];
+
+        // Announce first, then check the subscriber is still the one the
+        // mask was read for, so unsubscribe cannot free the ring under us
+        subscriber.publishers.fetch_add(1, std::memory_order_seq_cst);
+        if ((mask.load(std::memory_order_seq_cst) & (uint64_t{1} << id)) &&
+            subscriber.generation.load(std::memory_order_seq_cst) <= generation) {
+            if (!subscriber.ring->tryPush(event)) {
+                subscriber.dropped.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        subscriber.publishers.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+bool ProcessEventBus::valid(SubscriberID id) const {
+    return id >= 0 && static_cast<size_t>(id) < kMaxSubscribers &&
+           subscribers_[id].ring != nullptr;
+}
+
+} // namespace os_sim
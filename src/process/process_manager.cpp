@@ -1,41 +1,168 @@
 // src/process/process_manager.cpp
 #include "process/process_manager.hpp"
+#include "resource/resource_manager.hpp"
+#include "thread/block_pool.hpp"
+#include "thread/thread_pool.hpp"
 #include <algorithm>
+#include <chrono>
+#include <functional>
+#include <queue>
 
 namespace os_sim {
 
+namespace {
+
+ProcessStats combineStats(ProcessStats lhs, const ProcessStats& rhs) {
+    lhs.cpu_time += rhs.cpu_time;
+    lhs.ready_time += rhs.ready_time;
+    lhs.wait_time += rhs.wait_time;
+    lhs.memory_used += rhs.memory_used;
+    lhs.io_operations += rhs.io_operations;
+    lhs.context_switches += rhs.context_switches;
+    return lhs;
+}
+
+template<class T>
+std::vector<T> concatenate(std::vector<T> lhs, std::vector<T> rhs) {
+    lhs.insert(lhs.end(),
+               std::make_move_iterator(rhs.begin()),
+               std::make_move_iterator(rhs.end()));
+    return lhs;
+}
+
+} // namespace
+
 ProcessManager& ProcessManager::getInstance() {
     static ProcessManager instance;
     return instance;
 }
 
+ProcessManager::ProcessManager() {
+    setCpuCount(1);
+}
+
 std::shared_ptr<Process> ProcessManager::createProcess(
     const std::string& name, Priority priority) {
-    std::lock_guard<std::mutex> lock(manager_mutex_);
-    
     ProcessID pid = generateNextPID();
-    auto process = std::make_shared<Process>(pid, name, priority);
-    processes_[pid] = process;
-    
+    if (pid < 0) {
+        return nullptr;
+    }
+
+    // Process and control block share one pooled block
+    auto process = std::allocate_shared<Process>(PoolAllocator<Process>(), pid, name, priority);
+    process->setObserver(this);
+
+    // Home it on the least loaded CPU
+    size_t cpu = pickCpu();
+    process->setCpu(cpu);
+    updateSystemStats(cpu, process->getStats(), ProcessStats{});
+    {
+        std::lock_guard<std::mutex> cpu_lock(cpus_[cpu]->mutex);
+        cpus_[cpu]->members[pid] = process;
+    }
+
+    events_.publish({0, ProcessEventType::CREATED, pid, ProcessState::NEW,
+                     ProcessState::NEW, -1});
+    table_.insert(process);
+
     // Schedule the new process
     process->setState(ProcessState::READY);
     return process;
 }
 
 ErrorCode ProcessManager::terminateProcess(ProcessID pid) {
-    std::lock_guard<std::mutex> lock(manager_mutex_);
-    
-    auto it = processes_.find(pid);
-    if (it == processes_.end()) {
+    // Whoever removes the entry terminates the process
+    auto process = table_.remove(pid);
+    if (!process) {
         return ErrorCode::PROCESS_NOT_FOUND;
     }
-    
-    auto process = it->second;
-    process->setState(ProcessState::TERMINATED);
-    processes_.erase(it);
+
+    // It may have exited on its own and only be waiting for cleanup
+    if (process->getState() != ProcessState::TERMINATED) {
+        process->setState(ProcessState::TERMINATED);
+    }
+    retire(*process);
     return ErrorCode::SUCCESS;
 }
 
+std::vector<std::shared_ptr<Process>> ProcessManager::createProcesses(
+    const std::vector<ProcessSpec>& specs) {
+    std::vector<ProcessID> pids;
+    pids.reserve(specs.size());
+    if (!pids_.allocate(specs.size(), pids)) {
+        return {};
+    }
+
+    // Spread the batch over the CPUs, least loaded first
+    using Load = std::pair<size_t, size_t>;
+    std::priority_queue<Load, std::vector<Load>, std::greater<Load>> loads;
+    for (size_t cpu = 0; cpu < cpus_.size(); ++cpu) {
+        loads.emplace(cpus_[cpu]->ready_count.load(std::memory_order_relaxed) +
+                      cpus_[cpu]->running_count.load(std::memory_order_relaxed), cpu);
+    }
+
+    // Nothing can see these processes yet, so they go READY without the
+    // observer and join their run queues below
+    std::vector<std::shared_ptr<Process>> processes;
+    processes.reserve(specs.size());
+    std::vector<std::vector<size_t>> homed(cpus_.size());
+    std::vector<ProcessStats> joined(cpus_.size());
+    for (size_t i = 0; i < specs.size(); ++i) {
+        auto process = std::allocate_shared<Process>(
+            PoolAllocator<Process>(), pids[i], specs[i].name, specs[i].priority);
+        process->setState(ProcessState::READY);
+
+        auto [load, cpu] = loads.top();
+        loads.pop();
+        loads.emplace(load + 1, cpu);
+        process->setCpu(cpu);
+        process->setObserver(this);
+        homed[cpu].push_back(i);
+        joined[cpu] = combineStats(joined[cpu], process->getStats());
+        processes.push_back(std::move(process));
+    }
+
+    // Announced before a CPU can start them, so ahead of their transitions
+    if (events_.hasSubscribers(ProcessEventType::CREATED)) {
+        for (ProcessID pid : pids) {
+            events_.publish({0, ProcessEventType::CREATED, pid, ProcessState::NEW,
+                             ProcessState::READY, -1});
+        }
+    }
+
+    for (size_t index = 0; index < cpus_.size(); ++index) {
+        if (homed[index].empty()) {
+            continue;
+        }
+        updateSystemStats(index, joined[index], ProcessStats{});
+        Cpu& cpu = *cpus_[index];
+        std::lock_guard<std::mutex> lock(cpu.mutex);
+        for (size_t i : homed[index]) {
+            ProcessID pid = pids[i];
+            cpu.members[pid] = processes[i];
+            cpu.policy->enqueue(pid, specs[i].priority);
+            cpu.ready[pid] = specs[i].priority;
+        }
+        updateCounts(cpu);
+    }
+
+    table_.insert(processes);
+    return processes;
+}
+
+size_t ProcessManager::terminateProcesses(const std::vector<ProcessID>& pids) {
+    // Each transition still takes its process's lock: any of them may be
+    // running on a CPU right now
+    auto processes = table_.remove(pids);
+    for (const auto& process : processes) {
+        if (process->getState() != ProcessState::TERMINATED) {
+            process->setState(ProcessState::TERMINATED);
+        }
+        retire(*process);
+    }
+    return processes.size();
+}
+
 ErrorCode ProcessManager::suspendProcess(ProcessID pid) {
     auto process = getProcess(pid);
     if (!process) {
@@ -56,95 +183,509 @@ ErrorCode ProcessManager::resumeProcess(ProcessID pid) {
     return ErrorCode::SUCCESS;
 }
 
+bool ProcessManager::setCpuCount(size_t count) {
+    if (count == 0 || getProcessCount() != 0) {
+        return false;
+    }
+
+    std::string policy = cpus_.empty() ? "priority" : cpus_[0]->policy->getName();
+    cpus_.clear();
+    for (size_t i = 0; i < count; ++i) {
+        cpus_.push_back(std::make_unique<Cpu>());
+        cpus_.back()->policy = makeSchedulerPolicy(policy);
+    }
+    return true;
+}
+
+std::vector<CpuStats> ProcessManager::getCpuStats() const {
+    std::vector<CpuStats> stats;
+    stats.reserve(cpus_.size());
+    for (const auto& cpu : cpus_) {
+        std::lock_guard<std::mutex> lock(cpu->mutex);
+        stats.push_back(cpu->stats);
+        stats.back().ready = cpu->ready.size();
+        if (!cpu->running.empty()) {
+            stats.back().running = cpu->running.begin()->first;
+        }
+    }
+    return stats;
+}
+
 void ProcessManager::scheduleProcesses() {
-    std::lock_guard<std::mutex> lock(manager_mutex_);
-    
-    // First, handle any running process
-    for (const auto& [pid, process] : processes_) {
-        if (process->getState() == ProcessState::RUNNING) {
-            process->setState(ProcessState::READY);
-            break;  // Only one process should be running
+    for (size_t cpu = 0; cpu < cpus_.size(); ++cpu) {
+        scheduleCpu(cpu);
+    }
+}
+
+void ProcessManager::scheduleCpu(size_t index) {
+    Cpu& cpu = *cpus_[index];
+
+    // Charge the tick to the running process; it keeps the CPU until the
+    // policy says its slice is over
+    std::shared_ptr<Process> running;
+    bool expired = true;
+    bool balance;
+    {
+        std::lock_guard<std::mutex> lock(cpu.mutex);
+        if (!cpu.running.empty()) {
+            ProcessID pid = cpu.running.begin()->first;
+            expired = cpu.policy->tick(pid);
+            auto it = cpu.members.find(pid);
+            if (it != cpu.members.end()) {
+                running = it->second;
+            }
+            ++cpu.stats.busy_ticks;
+        } else {
+            ++cpu.stats.idle_ticks;
         }
+        balance = (cpu.stats.busy_ticks + cpu.stats.idle_ticks) % kBalanceInterval == 0;
     }
-    
-    // Get all ready processes
-    std::vector<std::shared_ptr<Process>> ready_processes;
-    for (const auto& [pid, process] : processes_) {
-        if (process->getState() == ProcessState::READY) {
-            ready_processes.push_back(process);
+
+    if (balance) {
+        balanceCpu(index);
+    }
+    if (running) {
+        if (!expired) {
+            return;
         }
+        running->compareAndSetState(ProcessState::RUNNING, ProcessState::READY);
     }
-    
-    if (ready_processes.empty()) {
+
+    // Start the policy's pick. The state may change between picking and
+    // starting it, so retry until one actually starts. An empty queue pulls
+    // work from the busiest CPU once before going idle.
+    bool pulled = false;
+    while (true) {
+        std::optional<ProcessID> pid;
+        std::shared_ptr<Process> next;
+        {
+            std::lock_guard<std::mutex> lock(cpu.mutex);
+            pid = cpu.policy->pickNext();
+            if (pid) {
+                cpu.ready.erase(*pid);
+                updateCounts(cpu);
+                auto it = cpu.members.find(*pid);
+                if (it != cpu.members.end()) {
+                    next = it->second;
+                }
+            }
+        }
+        if (!pid) {
+            if (pulled || !pullIdle(index)) {
+                return;
+            }
+            pulled = true;
+            continue;
+        }
+
+        if (next && next->compareAndSetState(ProcessState::READY, ProcessState::RUNNING)) {
+            return;
+        }
+    }
+}
+
+SchedulingReport ProcessManager::runScheduler(size_t ticks) {
+    SchedulingReport report;
+    report.ticks = ticks;
+    report.cpus = cpus_.size();
+
+    std::unordered_map<ProcessID, size_t> cpu_ticks;
+    std::vector<std::optional<ProcessID>> previous(cpus_.size());
+
+    // Everything READY or RUNNING at some sample counts as runnable
+    auto sample = [&](bool charge) {
+        for (size_t i = 0; i < cpus_.size(); ++i) {
+            Cpu& cpu = *cpus_[i];
+            std::optional<ProcessID> current;
+            {
+                std::lock_guard<std::mutex> lock(cpu.mutex);
+                for (const auto& [pid, _] : cpu.ready) {
+                    cpu_ticks.emplace(pid, 0);
+                }
+                if (!cpu.running.empty()) {
+                    current = cpu.running.begin()->first;
+                }
+            }
+            if (current) {
+                size_t& count = cpu_ticks[*current];
+                if (charge) {
+                    ++report.busy_ticks;
+                    ++count;
+                    if (current != previous[i]) {
+                        ++report.dispatches;
+                    }
+                }
+            }
+            previous[i] = current;
+        }
+    };
+
+    sample(false);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < ticks; ++i) {
+        scheduleProcesses();
+        sample(true);
+    }
+    std::chrono::duration<double, std::nano> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    report.ns_per_tick = ticks ? elapsed.count() / ticks : 0.0;
+    report.runnable = cpu_ticks.size();
+
+    double sum = 0.0;
+    double sum_squares = 0.0;
+    for (const auto& [pid, count] : cpu_ticks) {
+        if (count > 0) {
+            ++report.processes_run;
+        }
+        sum += count;
+        sum_squares += static_cast<double>(count) * count;
+    }
+    if (sum_squares > 0.0) {
+        report.fairness = sum * sum / (cpu_ticks.size() * sum_squares);
+    }
+    return report;
+}
+
+size_t ProcessManager::getReadyCount() const {
+    size_t count = 0;
+    for (const auto& cpu : cpus_) {
+        count += cpu->ready_count.load(std::memory_order_relaxed);
+    }
+    return count;
+}
+
+bool ProcessManager::setSchedulerPolicy(const std::string& name) {
+    if (!makeSchedulerPolicy(name)) {
+        return false;
+    }
+
+    for (const auto& cpu : cpus_) {
+        auto policy = makeSchedulerPolicy(name);
+        std::lock_guard<std::mutex> lock(cpu->mutex);
+        for (const auto& [pid, priority] : cpu->running) {
+            policy->updatePriority(pid, priority);
+        }
+        for (const auto& [pid, priority] : cpu->ready) {
+            policy->enqueue(pid, priority);
+        }
+        cpu->policy = std::move(policy);
+    }
+    return true;
+}
+
+std::string ProcessManager::getSchedulerPolicy() const {
+    std::lock_guard<std::mutex> lock(cpus_[0]->mutex);
+    return cpus_[0]->policy->getName();
+}
+
+void ProcessManager::onStateChanged(ProcessID pid, Priority priority, size_t index,
+                                    ProcessState old_state, ProcessState new_state) {
+    // Called with the process mutex held
+    table_.setState(pid, new_state);
+    events_.publish({0, ProcessEventType::STATE_CHANGED, pid, old_state, new_state, -1});
+
+    Cpu& cpu = *cpus_[index];
+    std::lock_guard<std::mutex> lock(cpu.mutex);
+
+    if (old_state == ProcessState::READY) {
+        // No-op when the policy itself picked pid
+        cpu.policy->remove(pid);
+        cpu.ready.erase(pid);
+    } else if (old_state == ProcessState::RUNNING) {
+        cpu.running.erase(pid);
+    }
+
+    if (new_state == ProcessState::READY) {
+        cpu.policy->enqueue(pid, priority);
+        cpu.ready[pid] = priority;
+    } else if (new_state == ProcessState::RUNNING) {
+        cpu.running[pid] = priority;
+        ++cpu.stats.dispatches;
+    } else if (new_state == ProcessState::TERMINATED) {
+        cpu.policy->forget(pid);
+        cpu.members.erase(pid);
+    }
+    updateCounts(cpu);
+}
+
+void ProcessManager::onPriorityChanged(ProcessID pid, ProcessState state, size_t index,
+                                       Priority /*old_priority*/, Priority new_priority) {
+    if (state == ProcessState::TERMINATED) {
         return;
     }
-    
-    // Sort by priority
-    std::sort(ready_processes.begin(), ready_processes.end(),
-        [](const auto& a, const auto& b) {
-            return a->getPriority() > b->getPriority();
-        });
-    
-    // Set highest priority process to RUNNING
-    ready_processes[0]->setState(ProcessState::RUNNING);
+    Cpu& cpu = *cpus_[index];
+    std::lock_guard<std::mutex> lock(cpu.mutex);
+    cpu.policy->updatePriority(pid, new_priority);
+
+    auto ready = cpu.ready.find(pid);
+    if (ready != cpu.ready.end()) {
+        ready->second = new_priority;
+    }
+    auto running = cpu.running.find(pid);
+    if (running != cpu.running.end()) {
+        running->second = new_priority;
+    }
+}
+
+bool ProcessManager::onMigrated(ProcessID pid, Priority priority,
+                                size_t from_cpu, size_t to_cpu) {
+    // Called with the process mutex held
+    Cpu& source = *cpus_[from_cpu];
+    Cpu& target = *cpus_[to_cpu];
+    std::scoped_lock lock(source.mutex, target.mutex);
+
+    // Refuse once the source has picked pid; it is about to start there
+    if (!source.ready.erase(pid)) {
+        return false;
+    }
+    source.policy->forget(pid);
+    auto member = source.members.find(pid);
+    target.members[pid] = std::move(member->second);
+    source.members.erase(member);
+    ++source.stats.migrations_out;
+    updateCounts(source);
+
+    // The target policy starts fresh accounting, e.g. CFS places it at the
+    // target's min_vruntime
+    target.ready[pid] = priority;
+    target.policy->enqueue(pid, priority);
+    ++target.stats.migrations_in;
+    updateCounts(target);
+    return true;
+}
+
+void ProcessManager::onStatsChanged(ProcessID /*pid*/, size_t cpu,
+                                    const ProcessStats& old_stats, const ProcessStats& new_stats) {
+    // Called with the process mutex held; atomics only
+    updateSystemStats(cpu, new_stats, old_stats);
+}
+
+void ProcessManager::onResourceChanged(ProcessID pid, ResourceID resource, bool allocated) {
+    events_.publish({0, allocated ? ProcessEventType::RESOURCE_ALLOCATED
+                                  : ProcessEventType::RESOURCE_RELEASED,
+                     pid, ProcessState::NEW, ProcessState::NEW, resource});
+}
+
+size_t ProcessManager::pickCpu() const {
+    size_t best = 0;
+    size_t best_load = SIZE_MAX;
+    for (size_t i = 0; i < cpus_.size(); ++i) {
+        size_t load = cpus_[i]->ready_count.load(std::memory_order_relaxed) +
+                      cpus_[i]->running_count.load(std::memory_order_relaxed);
+        if (load < best_load) {
+            best = i;
+            best_load = load;
+        }
+    }
+    return best;
+}
+
+void ProcessManager::balanceCpu(size_t index) {
+    // Periodic pass: pull half the difference from the busiest CPU when it
+    // is at least two processes ahead
+    auto load = [this](size_t i) {
+        return cpus_[i]->ready_count.load(std::memory_order_relaxed) +
+               cpus_[i]->running_count.load(std::memory_order_relaxed);
+    };
+
+    size_t busiest = index;
+    for (size_t i = 0; i < cpus_.size(); ++i) {
+        if (load(i) > load(busiest)) {
+            busiest = i;
+        }
+    }
+    size_t own = load(index);
+    size_t peak = load(busiest);
+    if (busiest != index && peak > own + 1) {
+        migrateReady(busiest, index, (peak - own) / 2);
+    }
+}
+
+bool ProcessManager::pullIdle(size_t index) {
+    size_t busiest = index;
+    size_t most = 0;
+    for (size_t i = 0; i < cpus_.size(); ++i) {
+        size_t ready = cpus_[i]->ready_count.load(std::memory_order_relaxed);
+        if (i != index && ready > most) {
+            busiest = i;
+            most = ready;
+        }
+    }
+    return busiest != index && migrateReady(busiest, index, 1) > 0;
+}
+
+size_t ProcessManager::migrateReady(size_t from_cpu, size_t to_cpu, size_t count) {
+    // Candidates are chosen under the source lock, then moved one by one
+    // through Process::migrate, which respects the process -> CPU lock order
+    std::vector<std::shared_ptr<Process>> candidates;
+    {
+        Cpu& source = *cpus_[from_cpu];
+        std::lock_guard<std::mutex> lock(source.mutex);
+        for (const auto& [pid, _] : source.ready) {
+            if (candidates.size() == count) {
+                break;
+            }
+            auto it = source.members.find(pid);
+            if (it != source.members.end()) {
+                candidates.push_back(it->second);
+            }
+        }
+    }
+
+    size_t moved = 0;
+    for (const auto& process : candidates) {
+        if (process->migrate(from_cpu, to_cpu)) {
+            ++moved;
+        }
+    }
+    return moved;
+}
+
+void ProcessManager::updateCounts(Cpu& cpu) {
+    // Caller holds cpu.mutex
+    cpu.ready_count.store(cpu.ready.size(), std::memory_order_relaxed);
+    cpu.running_count.store(cpu.running.size(), std::memory_order_relaxed);
 }
 
 std::shared_ptr<Process> ProcessManager::getProcess(ProcessID pid) {
-    std::lock_guard<std::mutex> lock(manager_mutex_);
-    auto it = processes_.find(pid);
-    return (it != processes_.end()) ? it->second : nullptr;
+    return table_.find(pid);
+}
+
+std::shared_ptr<Process> ProcessManager::getProcess(const ProcessHandle& handle) {
+    return table_.find(handle);
 }
 
 std::vector<ProcessID> ProcessManager::listProcesses() const {
-    std::lock_guard<std::mutex> lock(manager_mutex_);
     std::vector<ProcessID> pids;
-    pids.reserve(processes_.size());
+    pids.reserve(getProcessCount());
     
-    for (const auto& [pid, _] : processes_) {
-        pids.push_back(pid);
+    for (size_t page = 0; page < table_.pageCount(); ++page) {
+        table_.forEach(page, [&pids](ProcessID pid, const auto&) {
+            pids.push_back(pid);
+        });
     }
     
     return pids;
 }
 
-size_t ProcessManager::getProcessCount() const {
-    std::lock_guard<std::mutex> lock(manager_mutex_);
-    return processes_.size();
+std::shared_ptr<const ProcessSnapshot> ProcessManager::getSnapshot(
+    std::chrono::steady_clock::duration max_age) {
+    using Clock = std::chrono::steady_clock;
+    auto recent = [max_age](const std::shared_ptr<const ProcessSnapshot>& snapshot) {
+        return snapshot && max_age > Clock::duration::zero() &&
+               Clock::now() - snapshot->taken_at <= max_age;
+    };
+
+    auto latest = std::atomic_load(&snapshot_);
+    if (recent(latest)) {
+        return latest;
+    }
+
+    std::lock_guard<std::mutex> lock(snapshot_mutex_);
+    latest = std::atomic_load(&snapshot_);
+    if (recent(latest)) {
+        return latest;
+    }
+
+    auto snapshot = std::make_shared<ProcessSnapshot>();
+    snapshot->taken_at = Clock::now();
+    snapshot->reserve(getProcessCount());
+    for (size_t page = 0; page < table_.pageCount(); ++page) {
+        table_.forEach(page, [&snapshot](ProcessID, const auto& process) {
+            process->appendTo(*snapshot);
+        });
+    }
+
+    std::shared_ptr<const ProcessSnapshot> published = std::move(snapshot);
+    std::atomic_store(&snapshot_, published);
+    return published;
 }
 
 ProcessStats ProcessManager::getSystemStats() const {
-    std::lock_guard<std::mutex> lock(manager_mutex_);
     ProcessStats system_stats;
-    
-    for (const auto& [_, process] : processes_) {
-        const auto& stats = process->getStats();
-        system_stats.cpu_time += stats.cpu_time;
-        system_stats.memory_used += stats.memory_used;
-        system_stats.io_operations += stats.io_operations;
-        system_stats.context_switches += stats.context_switches;
+    for (const auto& cpu : cpus_) {
+        const StatsTotals& totals = cpu->totals;
+        system_stats.cpu_time += totals.cpu_time.load(std::memory_order_relaxed);
+        system_stats.ready_time += totals.ready_time.load(std::memory_order_relaxed);
+        system_stats.wait_time += totals.wait_time.load(std::memory_order_relaxed);
+        system_stats.memory_used += totals.memory_used.load(std::memory_order_relaxed);
+        system_stats.io_operations += totals.io_operations.load(std::memory_order_relaxed);
+        system_stats.context_switches +=
+            totals.context_switches.load(std::memory_order_relaxed);
     }
-    
     return system_stats;
 }
 
+void ProcessManager::setThreadPool(ThreadPool* pool) {
+    thread_pool_ = pool;
+}
+
+std::vector<std::shared_ptr<Process>>
+ProcessManager::collectProcessesInState(ProcessState state) const {
+    using ProcessList = std::vector<std::shared_ptr<Process>>;
+
+    // Filters on the table's state words; only matches touch a Process
+    auto collect = [this, state](size_t first, size_t last, ProcessList matches) {
+        for (size_t page = first; page < last; ++page) {
+            table_.forEachInState(page, state, [&matches](ProcessID, const auto& process) {
+                matches.push_back(process);
+            });
+        }
+        return matches;
+    };
+
+    size_t pages = table_.pageCount();
+    ThreadPool* pool = thread_pool_.load();
+    if (pool && getProcessCount() >= kParallelSweepThreshold) {
+        return pool->parallelReduce(0, pages, kSweepGrain, ProcessList{},
+                                    collect, concatenate<std::shared_ptr<Process>>);
+    }
+    return collect(0, pages, ProcessList{});
+}
+
 ProcessID ProcessManager::generateNextPID() {
-    return next_pid_++;
+    return pids_.allocate();
+}
+
+void ProcessManager::retire(Process& process) {
+    // Anything still holding the Process object keeps it alive, so give
+    // back its resources here rather than in its destructor before the pid
+    // can name another process
+    for (ResourceID resource_id : process.getAllocatedResources()) {
+        process.releaseResource(resource_id);
+    }
+    ResourceManager::getInstance().releaseAllUnits(process.getPID());
+    // Out of the system totals from here on, whoever still holds it
+    updateSystemStats(process.getCpu(), ProcessStats{}, process.detachObserver());
+    events_.publish({0, ProcessEventType::TERMINATED, process.getPID(),
+                     ProcessState::NEW, ProcessState::TERMINATED, -1});
+    pids_.free(process.getPID());
 }
 
 void ProcessManager::cleanupTerminatedProcesses() {
-    std::lock_guard<std::mutex> lock(manager_mutex_);
-    
-    for (auto it = processes_.begin(); it != processes_.end();) {
-        if (it->second->getState() == ProcessState::TERMINATED) {
-            it = processes_.erase(it);
-        } else {
-            ++it;
+    for (const auto& process : collectProcessesInState(ProcessState::TERMINATED)) {
+        if (table_.remove(process->getPID(), process.get())) {
+            retire(*process);
         }
     }
 }
 
-void ProcessManager::updateSystemStats() {
-    // This could be expanded to track additional system-wide metrics
+void ProcessManager::updateSystemStats(size_t index, const ProcessStats& added,
+                                       const ProcessStats& removed) {
+    // Differences wrap modulo 2^64 and come out right once summed
+    auto apply = [](std::atomic<uint64_t>& total, uint64_t delta) {
+        if (delta != 0) {
+            total.fetch_add(delta, std::memory_order_relaxed);
+        }
+    };
+    StatsTotals& totals = cpus_[index]->totals;
+    apply(totals.cpu_time, added.cpu_time - removed.cpu_time);
+    apply(totals.ready_time, added.ready_time - removed.ready_time);
+    apply(totals.wait_time, added.wait_time - removed.wait_time);
+    apply(totals.memory_used, added.memory_used - removed.memory_used);
+    apply(totals.io_operations, added.io_operations - removed.io_operations);
+    apply(totals.context_switches, added.context_switches - removed.context_switches);
 }
 
 } // namespace os_sim
\ No newline at end of file
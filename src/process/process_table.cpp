@@ -0,0 +1,240 @@
+// src/process/process_table.cpp
+#include "process/process_table.hpp"
+
+namespace os_sim {
+
+ProcessTable::Page::Page() {
+    for (auto& word : words) {
+        word.store(makeWord(0, kVacant), std::memory_order_relaxed);
+    }
+}
+
+ProcessTable::ProcessTable() = default;
+
+ProcessTable::~ProcessTable() {
+    for (auto& entry : directory_) {
+        Block* block = entry.load(std::memory_order_relaxed);
+        if (!block) {
+            continue;
+        }
+        for (auto& page : *block) {
+            delete page.load(std::memory_order_relaxed);
+        }
+        delete block;
+    }
+}
+
+bool ProcessTable::insert(const std::shared_ptr<Process>& process) {
+    ProcessID pid = process->getPID();
+    Page* page = pid < 0 ? nullptr : pageFor(pid, true);
+    if (!page) {
+        return false;
+    }
+
+    {
+        std::unique_lock<std::shared_mutex> lock(page->mutex);
+        if (!fill(*page, static_cast<size_t>(pid) % kPageSize, process)) {
+            return false;
+        }
+    }
+    size_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+size_t ProcessTable::insert(const std::vector<std::shared_ptr<Process>>& processes) {
+    size_t inserted = 0;
+    for (size_t run = 0; run < processes.size();) {
+        ProcessID pid = processes[run]->getPID();
+        Page* page = pid < 0 ? nullptr : pageFor(pid, true);
+        if (!page) {
+            ++run;
+            continue;
+        }
+
+        size_t index = static_cast<size_t>(pid) / kPageSize;
+        std::unique_lock<std::shared_mutex> lock(page->mutex);
+        for (; run < processes.size(); ++run) {
+            pid = processes[run]->getPID();
+            if (pid < 0 || static_cast<size_t>(pid) / kPageSize != index) {
+                break;
+            }
+            inserted += fill(*page, static_cast<size_t>(pid) % kPageSize, processes[run]);
+        }
+    }
+    size_.fetch_add(inserted, std::memory_order_relaxed);
+    return inserted;
+}
+
+std::shared_ptr<Process> ProcessTable::remove(ProcessID pid, const Process* expected) {
+    Page* page = pid < 0 ? nullptr : pageFor(pid, false);
+    if (!page) {
+        return nullptr;
+    }
+
+    std::shared_ptr<Process> process;
+    {
+        std::unique_lock<std::shared_mutex> lock(page->mutex);
+        process = vacate(*page, static_cast<size_t>(pid) % kPageSize, expected);
+    }
+    if (process) {
+        size_.fetch_sub(1, std::memory_order_relaxed);
+    }
+    return process;
+}
+
+std::vector<std::shared_ptr<Process>> ProcessTable::remove(const std::vector<ProcessID>& pids) {
+    std::vector<std::shared_ptr<Process>> removed;
+    for (size_t run = 0; run < pids.size();) {
+        Page* page = pids[run] < 0 ? nullptr : pageFor(pids[run], false);
+        if (!page) {
+            ++run;
+            continue;
+        }
+
+        size_t index = static_cast<size_t>(pids[run]) / kPageSize;
+        std::unique_lock<std::shared_mutex> lock(page->mutex);
+        for (; run < pids.size(); ++run) {
+            if (pids[run] < 0 || static_cast<size_t>(pids[run]) / kPageSize != index) {
+                break;
+            }
+            if (auto process = vacate(*page, static_cast<size_t>(pids[run]) % kPageSize, nullptr)) {
+                removed.push_back(std::move(process));
+            }
+        }
+    }
+    size_.fetch_sub(removed.size(), std::memory_order_relaxed);
+    return removed;
+}
+
+bool ProcessTable::fill(Page& page, size_t slot, const std::shared_ptr<Process>& process) {
+    uint64_t word = page.words[slot].load(std::memory_order_relaxed);
+    if (stateOf(word) != kVacant) {
+        return false;
+    }
+    page.processes[slot] = process;
+    ProcessState state = process->getState();
+    page.words[slot].store(makeWord(generationOf(word), encode(state)), std::memory_order_relaxed);
+
+    // A process already on a run queue can change state meanwhile, and a
+    // transition that still saw the slot vacant did not update it
+    for (ProcessState now = process->getState(); now != state; now = process->getState()) {
+        state = now;
+        page.words[slot].store(makeWord(generationOf(word), encode(state)),
+                               std::memory_order_relaxed);
+    }
+    return true;
+}
+
+std::shared_ptr<Process> ProcessTable::vacate(Page& page, size_t slot, const Process* expected) {
+    uint64_t word = page.words[slot].load(std::memory_order_relaxed);
+    if (stateOf(word) == kVacant || (expected && page.processes[slot].get() != expected)) {
+        return nullptr;
+    }
+    page.words[slot].store(makeWord(generationOf(word) + 1, kVacant), std::memory_order_relaxed);
+    return std::move(page.processes[slot]);
+}
+
+std::shared_ptr<Process> ProcessTable::find(ProcessID pid) const {
+    const Page* page = pid < 0 ? nullptr : pageAt(static_cast<size_t>(pid) / kPageSize);
+    if (!page) {
+        return nullptr;
+    }
+
+    std::shared_lock<std::shared_mutex> lock(page->mutex);
+    return page->processes[static_cast<size_t>(pid) % kPageSize];
+}
+
+std::shared_ptr<Process> ProcessTable::find(const ProcessHandle& handle) const {
+    ProcessID pid = handle.pid;
+    const Page* page = pid < 0 ? nullptr : pageAt(static_cast<size_t>(pid) / kPageSize);
+    if (!page) {
+        return nullptr;
+    }
+
+    size_t slot = static_cast<size_t>(pid) % kPageSize;
+    std::shared_lock<std::shared_mutex> lock(page->mutex);
+    uint64_t word = page->words[slot].load(std::memory_order_relaxed);
+    if (stateOf(word) == kVacant || generationOf(word) != handle.generation) {
+        return nullptr;
+    }
+    return page->processes[slot];
+}
+
+ProcessHandle ProcessTable::handleOf(ProcessID pid) const {
+    const Page* page = pid < 0 ? nullptr : pageAt(static_cast<size_t>(pid) / kPageSize);
+    if (!page) {
+        return {};
+    }
+
+    size_t slot = static_cast<size_t>(pid) % kPageSize;
+    uint64_t word = page->words[slot].load(std::memory_order_relaxed);
+    if (stateOf(word) == kVacant) {
+        return {};
+    }
+    return {pid, generationOf(word)};
+}
+
+void ProcessTable::setState(ProcessID pid, ProcessState state) {
+    Page* page = pid < 0 ? nullptr : pageFor(pid, false);
+    if (!page) {
+        return;
+    }
+
+    // A failed exchange means the slot changed underneath; re-check it is
+    // still live, since removal bumps the generation
+    auto& entry = page->words[static_cast<size_t>(pid) % kPageSize];
+    uint64_t word = entry.load(std::memory_order_relaxed);
+    while (stateOf(word) != kVacant &&
+           !entry.compare_exchange_weak(word, makeWord(generationOf(word), encode(state)),
+                                        std::memory_order_relaxed)) {
+    }
+}
+
+const ProcessTable::Page* ProcessTable::pageAt(size_t page) const {
+    if (page / kBlockSize >= kDirectorySize) {
+        return nullptr;
+    }
+    const Block* block = directory_[page / kBlockSize].load(std::memory_order_acquire);
+    return block ? (*block)[page % kBlockSize].load(std::memory_order_acquire) : nullptr;
+}
+
+ProcessTable::Page* ProcessTable::pageFor(ProcessID pid, bool create) {
+    size_t index = static_cast<size_t>(pid) / kPageSize;
+    auto& block_entry = directory_[index / kBlockSize];
+
+    // Racing creators each build a block or page; the loser frees its own
+    Block* block = block_entry.load(std::memory_order_acquire);
+    if (!block) {
+        if (!create) {
+            return nullptr;
+        }
+        auto* fresh = new Block();
+        if (block_entry.compare_exchange_strong(block, fresh, std::memory_order_acq_rel)) {
+            block = fresh;
+        } else {
+            delete fresh;
+        }
+    }
+
+    auto& page_entry = (*block)[index % kBlockSize];
+    Page* page = page_entry.load(std::memory_order_acquire);
+    if (!page) {
+        if (!create) {
+            return nullptr;
+        }
+        auto* fresh = new Page();
+        if (page_entry.compare_exchange_strong(page, fresh, std::memory_order_acq_rel)) {
+            page = fresh;
+        } else {
+            delete fresh;
+        }
+    }
+
+    size_t count = page_count_.load(std::memory_order_relaxed);
+    while (count <= index &&
+           !page_count_.compare_exchange_weak(count, index + 1, std::memory_order_release)) {
+    }
+    return page;
+}
+
+} // namespace os_sim
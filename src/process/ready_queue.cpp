@@ -0,0 +1,117 @@
+// src/process/ready_queue.cpp
+#include "process/ready_queue.hpp"
+
+namespace os_sim {
+
+void ReadyQueue::push(ProcessID pid, Priority priority) {
+    Entry entry{priority, next_sequence_++, pid};
+
+    auto it = index_.find(pid);
+    if (it != index_.end()) {
+        size_t slot = it->second;
+        place(slot, entry);
+        siftUp(slot);
+        siftDown(index_[pid]);
+        return;
+    }
+
+    heap_.push_back(entry);
+    index_[pid] = heap_.size() - 1;
+    siftUp(heap_.size() - 1);
+}
+
+bool ReadyQueue::remove(ProcessID pid) {
+    auto it = index_.find(pid);
+    if (it == index_.end()) {
+        return false;
+    }
+    erase(it->second);
+    return true;
+}
+
+bool ReadyQueue::updatePriority(ProcessID pid, Priority priority) {
+    auto it = index_.find(pid);
+    if (it == index_.end()) {
+        return false;
+    }
+
+    size_t slot = it->second;
+    Entry entry = heap_[slot];
+    entry.priority = priority;
+    place(slot, entry);
+    siftUp(slot);
+    siftDown(index_[pid]);
+    return true;
+}
+
+std::optional<ProcessID> ReadyQueue::top() const {
+    if (heap_.empty()) {
+        return std::nullopt;
+    }
+    return heap_.front().pid;
+}
+
+std::optional<ProcessID> ReadyQueue::pop() {
+    if (heap_.empty()) {
+        return std::nullopt;
+    }
+    ProcessID pid = heap_.front().pid;
+    erase(0);
+    return pid;
+}
+
+void ReadyQueue::place(size_t slot, Entry entry) {
+    index_[entry.pid] = slot;
+    heap_[slot] = entry;
+}
+
+void ReadyQueue::siftUp(size_t slot) {
+    Entry entry = heap_[slot];
+    while (slot > 0) {
+        size_t parent = (slot - 1) / 2;
+        if (!before(entry, heap_[parent])) {
+            break;
+        }
+        place(slot, heap_[parent]);
+        slot = parent;
+    }
+    place(slot, entry);
+}
+
+void ReadyQueue::siftDown(size_t slot) {
+    Entry entry = heap_[slot];
+    size_t count = heap_.size();
+    while (true) {
+        size_t child = 2 * slot + 1;
+        if (child >= count) {
+            break;
+        }
+        if (child + 1 < count && before(heap_[child + 1], heap_[child])) {
+            ++child;
+        }
+        if (!before(heap_[child], entry)) {
+            break;
+        }
+        place(slot, heap_[child]);
+        slot = child;
+    }
+    place(slot, entry);
+}
+
+void ReadyQueue::erase(size_t slot) {
+    index_.erase(heap_[slot].pid);
+
+    size_t last = heap_.size() - 1;
+    if (slot != last) {
+        // Move the last entry into the hole, then restore heap order
+        ProcessID moved = heap_[last].pid;
+        place(slot, heap_[last]);
+        heap_.pop_back();
+        siftUp(slot);
+        siftDown(index_[moved]);
+    } else {
+        heap_.pop_back();
+    }
+}
+
+} // namespace os_sim
@@ -0,0 +1,378 @@
+// src/process/scheduler_policy.cpp
+#include "process/scheduler_policy.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace os_sim {
+
+uint64_t priorityWeight(Priority priority) {
+    Priority clamped = std::clamp<Priority>(priority, -20, 19);
+    auto weight = std::llround(1024.0 * std::pow(1.25, clamped));
+    return static_cast<uint64_t>(std::max<long long>(weight, 1));
+}
+
+// PriorityPolicy
+
+void PriorityPolicy::enqueue(ProcessID pid, Priority priority) {
+    queue_.push(pid, priority);
+}
+
+void PriorityPolicy::remove(ProcessID pid) {
+    queue_.remove(pid);
+}
+
+void PriorityPolicy::updatePriority(ProcessID pid, Priority priority) {
+    queue_.updatePriority(pid, priority);
+}
+
+void PriorityPolicy::forget(ProcessID pid) {
+    queue_.remove(pid);
+}
+
+std::optional<ProcessID> PriorityPolicy::pickNext() {
+    return queue_.pop();
+}
+
+bool PriorityPolicy::tick(ProcessID /*running*/) {
+    return true;
+}
+
+// MlfqPolicy
+
+void MlfqPolicy::enqueue(ProcessID pid, Priority /*priority*/) {
+    Entry& entry = entries_[pid];
+    if (entry.queued) {
+        return;
+    }
+
+    if (entry.used >= quantum(entry.level)) {
+        entry.level = std::min(entry.level + 1, kLevels - 1);
+        entry.used = 0;
+    }
+    auto& level = levels_[entry.level];
+    entry.position = level.insert(level.end(), pid);
+    entry.queued = true;
+    ++queued_;
+}
+
+void MlfqPolicy::remove(ProcessID pid) {
+    auto it = entries_.find(pid);
+    if (it == entries_.end() || !it->second.queued) {
+        return;
+    }
+    levels_[it->second.level].erase(it->second.position);
+    it->second.queued = false;
+    --queued_;
+}
+
+void MlfqPolicy::updatePriority(ProcessID pid, Priority /*priority*/) {
+    entries_.try_emplace(pid);
+}
+
+void MlfqPolicy::forget(ProcessID pid) {
+    remove(pid);
+    entries_.erase(pid);
+}
+
+std::optional<ProcessID> MlfqPolicy::pickNext() {
+    for (auto& level : levels_) {
+        if (!level.empty()) {
+            ProcessID pid = level.front();
+            level.pop_front();
+            entries_[pid].queued = false;
+            --queued_;
+            return pid;
+        }
+    }
+    return std::nullopt;
+}
+
+bool MlfqPolicy::tick(ProcessID running) {
+    if (++ticks_ % kBoostInterval == 0) {
+        boost();
+    }
+
+    Entry& entry = entries_[running];
+    ++entry.used;
+    if (entry.used >= quantum(entry.level)) {
+        return true;
+    }
+    // A process waiting on a higher level preempts immediately
+    for (size_t level = 0; level < entry.level; ++level) {
+        if (!levels_[level].empty()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void MlfqPolicy::boost() {
+    // splice keeps the stored list iterators valid
+    for (size_t level = 1; level < kLevels; ++level) {
+        levels_[0].splice(levels_[0].end(), levels_[level]);
+    }
+    for (auto& [pid, entry] : entries_) {
+        entry.level = 0;
+        entry.used = 0;
+    }
+}
+
+// CfsPolicy
+
+CfsPolicy::Entry& CfsPolicy::entryFor(ProcessID pid, Priority priority) {
+    auto [it, inserted] = entries_.try_emplace(pid);
+    if (inserted) {
+        it->second.vruntime = min_vruntime_;
+        it->second.weight = priorityWeight(priority);
+    }
+    return it->second;
+}
+
+void CfsPolicy::enqueue(ProcessID pid, Priority priority) {
+    Entry& entry = entryFor(pid, priority);
+    if (entry.queued) {
+        return;
+    }
+
+    entry.weight = priorityWeight(priority);
+    entry.vruntime = std::max(entry.vruntime, min_vruntime_);
+    timeline_.emplace(entry.vruntime, pid);
+    entry.queued = true;
+}
+
+void CfsPolicy::remove(ProcessID pid) {
+    auto it = entries_.find(pid);
+    if (it == entries_.end() || !it->second.queued) {
+        return;
+    }
+    timeline_.erase({it->second.vruntime, pid});
+    it->second.queued = false;
+}
+
+void CfsPolicy::updatePriority(ProcessID pid, Priority priority) {
+    // The tree is keyed by vruntime only, so nothing moves
+    entryFor(pid, priority).weight = priorityWeight(priority);
+}
+
+void CfsPolicy::forget(ProcessID pid) {
+    remove(pid);
+    entries_.erase(pid);
+}
+
+std::optional<ProcessID> CfsPolicy::pickNext() {
+    if (timeline_.empty()) {
+        return std::nullopt;
+    }
+
+    auto [vruntime, pid] = *timeline_.begin();
+    timeline_.erase(timeline_.begin());
+    entries_[pid].queued = false;
+    min_vruntime_ = std::max(min_vruntime_, vruntime);
+    return pid;
+}
+
+bool CfsPolicy::tick(ProcessID running) {
+    Entry& entry = entryFor(running, 0);
+    entry.vruntime += std::max<uint64_t>(kTickNs * priorityWeight(0) / entry.weight, 1);
+
+    return !timeline_.empty() &&
+           entry.vruntime >= timeline_.begin()->first + kGranularityNs;
+}
+
+// StridePolicy
+
+StridePolicy::Entry& StridePolicy::entryFor(ProcessID pid, Priority priority) {
+    auto [it, inserted] = entries_.try_emplace(pid);
+    if (inserted) {
+        it->second.pass = global_pass_;
+        it->second.stride = kStride1 / priorityWeight(priority);
+    }
+    return it->second;
+}
+
+void StridePolicy::enqueue(ProcessID pid, Priority priority) {
+    Entry& entry = entryFor(pid, priority);
+    if (entry.queued) {
+        return;
+    }
+
+    entry.stride = kStride1 / priorityWeight(priority);
+    entry.pass = std::max(entry.pass, global_pass_);
+    queue_.emplace(entry.pass, pid);
+    entry.queued = true;
+}
+
+void StridePolicy::remove(ProcessID pid) {
+    auto it = entries_.find(pid);
+    if (it == entries_.end() || !it->second.queued) {
+        return;
+    }
+    queue_.erase({it->second.pass, pid});
+    it->second.queued = false;
+}
+
+void StridePolicy::updatePriority(ProcessID pid, Priority priority) {
+    entryFor(pid, priority).stride = kStride1 / priorityWeight(priority);
+}
+
+void StridePolicy::forget(ProcessID pid) {
+    remove(pid);
+    entries_.erase(pid);
+}
+
+std::optional<ProcessID> StridePolicy::pickNext() {
+    if (queue_.empty()) {
+        return std::nullopt;
+    }
+
+    auto [pass, pid] = *queue_.begin();
+    queue_.erase(queue_.begin());
+    entries_[pid].queued = false;
+    global_pass_ = std::max(global_pass_, pass);
+    return pid;
+}
+
+bool StridePolicy::tick(ProcessID running) {
+    Entry& entry = entryFor(running, 0);
+    entry.pass += entry.stride;
+    return true;
+}
+
+// LotteryPolicy
+
+LotteryPolicy::LotteryPolicy(uint64_t seed)
+    : tree_(1, 0)
+    , random_(seed)
+{
+}
+
+void LotteryPolicy::enqueue(ProcessID pid, Priority priority) {
+    uint64_t tickets = priorityWeight(priority);
+    tickets_[pid] = tickets;
+    if (slots_.count(pid)) {
+        return;
+    }
+
+    size_t slot;
+    if (!free_slots_.empty()) {
+        slot = free_slots_.back();
+        free_slots_.pop_back();
+    } else {
+        // Appending to a Fenwick tree: the new node covers the empty slot
+        // plus the slots below it in its range
+        slot = slot_pids_.size();
+        slot_pids_.push_back(pid);
+        slot_tickets_.push_back(0);
+        size_t node = slot + 1;
+        tree_.push_back(prefix(node - 1) - prefix(node - (node & -node)));
+    }
+
+    slot_pids_[slot] = pid;
+    slot_tickets_[slot] = tickets;
+    add(slot, static_cast<int64_t>(tickets));
+    total_tickets_ += tickets;
+    slots_[pid] = slot;
+}
+
+void LotteryPolicy::remove(ProcessID pid) {
+    auto it = slots_.find(pid);
+    if (it != slots_.end()) {
+        release(it->second);
+    }
+}
+
+void LotteryPolicy::updatePriority(ProcessID pid, Priority priority) {
+    uint64_t tickets = priorityWeight(priority);
+    tickets_[pid] = tickets;
+
+    auto it = slots_.find(pid);
+    if (it == slots_.end()) {
+        return;
+    }
+    size_t slot = it->second;
+    add(slot, static_cast<int64_t>(tickets) - static_cast<int64_t>(slot_tickets_[slot]));
+    total_tickets_ = total_tickets_ - slot_tickets_[slot] + tickets;
+    slot_tickets_[slot] = tickets;
+}
+
+void LotteryPolicy::forget(ProcessID pid) {
+    remove(pid);
+    tickets_.erase(pid);
+}
+
+std::optional<ProcessID> LotteryPolicy::pickNext() {
+    if (slots_.empty()) {
+        return std::nullopt;
+    }
+
+    std::uniform_int_distribution<uint64_t> draw(0, total_tickets_ - 1);
+    size_t slot = find(draw(random_));
+    ProcessID pid = slot_pids_[slot];
+    release(slot);
+    return pid;
+}
+
+bool LotteryPolicy::tick(ProcessID /*running*/) {
+    return true;
+}
+
+void LotteryPolicy::add(size_t slot, int64_t delta) {
+    for (size_t node = slot + 1; node < tree_.size(); node += node & -node) {
+        tree_[node] += static_cast<uint64_t>(delta);
+    }
+}
+
+uint64_t LotteryPolicy::prefix(size_t count) const {
+    uint64_t sum = 0;
+    for (size_t node = count; node > 0; node -= node & -node) {
+        sum += tree_[node];
+    }
+    return sum;
+}
+
+size_t LotteryPolicy::find(uint64_t ticket) const {
+    size_t count = tree_.size() - 1;
+    size_t step = 1;
+    while (step * 2 <= count) {
+        step *= 2;
+    }
+
+    // Largest position whose prefix sum is still <= ticket
+    size_t position = 0;
+    for (; step > 0; step /= 2) {
+        if (position + step <= count && tree_[position + step] <= ticket) {
+            position += step;
+            ticket -= tree_[position];
+        }
+    }
+    return position;
+}
+
+void LotteryPolicy::release(size_t slot) {
+    uint64_t tickets = slot_tickets_[slot];
+    add(slot, -static_cast<int64_t>(tickets));
+    total_tickets_ -= tickets;
+    slot_tickets_[slot] = 0;
+    slots_.erase(slot_pids_[slot]);
+    free_slots_.push_back(slot);
+}
+
+// Factory
+
+std::unique_ptr<SchedulerPolicy> makeSchedulerPolicy(const std::string& name) {
+    if (name == "priority") return std::make_unique<PriorityPolicy>();
+    if (name == "mlfq") return std::make_unique<MlfqPolicy>();
+    if (name == "cfs") return std::make_unique<CfsPolicy>();
+    if (name == "stride") return std::make_unique<StridePolicy>();
+    if (name == "lottery") return std::make_unique<LotteryPolicy>();
+    return nullptr;
+}
+
+const std::vector<std::string>& schedulerPolicyNames() {
+    static const std::vector<std::string> names = {
+        "priority", "mlfq", "cfs", "stride", "lottery"
+    };
+    return names;
+}
+
+} // namespace os_sim
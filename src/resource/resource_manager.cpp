@@ -1,6 +1,7 @@
 // src/resource/resource_manager.cpp
 #include "resource/resource_manager.hpp"
 #include "process/process.hpp"
+#include "thread/thread_pool.hpp"
 #include <algorithm>
 #include <iostream>
 #include <thread>
@@ -8,29 +9,24 @@
 namespace os_sim {
 
 ResourceManager& ResourceManager::getInstance() {
-    std::cout << "Getting ResourceManager instance..." << std::endl;
     static ResourceManager instance;
-    std::cout << "ResourceManager instance created." << std::endl;
     return instance;
 }
 
 ResourceManager::ResourceManager() {
-    std::cout << "Creating ResourceManager..." << std::endl;
-    try {
-        // Create resources without locking in constructor
-        resources_[0] = ResourceType::CPU;
-        resources_[1] = ResourceType::MEMORY;
-        resources_[2] = ResourceType::FILE;
-        resources_[3] = ResourceType::NETWORK;
-        resources_[4] = ResourceType::GENERIC;
-        next_resource_id_ = 5;  // Set next ID after initialization
-        
-        std::cout << "ResourceManager: Created 5 default resources" << std::endl;
-    } catch (const std::exception& e) {
-        std::cout << "Exception during initialization: " << e.what() << std::endl;
-        throw;
-    }
-    std::cout << "ResourceManager constructor complete." << std::endl;
+    // Create resources without locking in constructor
+    resources_[0] = ResourceType::CPU;
+    resources_[1] = ResourceType::MEMORY;
+    resources_[2] = ResourceType::FILE;
+    resources_[3] = ResourceType::NETWORK;
+    resources_[4] = ResourceType::GENERIC;
+    next_resource_id_ = 5;  // Set next ID after initialization
+
+    units_.setTotal(static_cast<size_t>(ResourceType::CPU), 16);
+    units_.setTotal(static_cast<size_t>(ResourceType::MEMORY), 64 * 1024);  // MiB
+    units_.setTotal(static_cast<size_t>(ResourceType::FILE), 1024);
+    units_.setTotal(static_cast<size_t>(ResourceType::NETWORK), 64);
+    units_.setTotal(static_cast<size_t>(ResourceType::GENERIC), 64);
 }
 
 void ResourceManager::initializeDefaultResources() {
@@ -113,35 +109,166 @@ ErrorCode ResourceManager::allocateResource(ProcessID pid, ResourceID resource_i
         return ErrorCode::RESOURCE_NOT_AVAILABLE;
     }
     
-    // Allocate the resource
-    allocations_[resource_id] = pid;
-    process_resources_[pid].push_back(resource_id);
-    
+    grant(pid, resource_id);
     return ErrorCode::SUCCESS;
 }
 
 ErrorCode ResourceManager::releaseResource(ProcessID pid, ResourceID resource_id) {
     std::lock_guard<std::mutex> lock(resource_mutex_);
-    
+    return giveBack(pid, resource_id);
+}
+
+ErrorCode ResourceManager::acquireResource(ProcessID pid, ResourceID resource_id,
+                                           std::chrono::milliseconds timeout,
+                                           std::unique_lock<std::mutex>* held) {
+    std::unique_lock<std::mutex> lock(resource_mutex_);
+    auto unlockHeld = [held] {
+        if (held && held->owns_lock()) {
+            held->unlock();
+        }
+    };
+
+    if (resources_.find(resource_id) == resources_.end()) {
+        unlockHeld();
+        return ErrorCode::RESOURCE_NOT_AVAILABLE;
+    }
+    auto holder = allocations_.find(resource_id);
+    if (holder == allocations_.end()) {
+        grant(pid, resource_id);
+        unlockHeld();
+        return ErrorCode::SUCCESS;
+    }
+    if (holder->second == pid || waiting_for_.count(pid) != 0) {
+        unlockHeld();
+        return ErrorCode::OPERATION_FAILED;
+    }
+    if (timeout <= std::chrono::milliseconds::zero()) {
+        unlockHeld();
+        return ErrorCode::RESOURCE_NOT_AVAILABLE;
+    }
+
+    // Whoever ends the wait sets the result and dequeues us
+    Waiter waiter{pid};
+    wait_queues_[resource_id].push_back(&waiter);
+    waiting_for_[pid] = resource_id;
+    unlockHeld();
+
+    auto done = [&waiter] { return waiter.done; };
+    if (timeout == kWaitForever) {
+        waiter.cv.wait(lock, done);
+    } else if (!waiter.cv.wait_for(lock, timeout, done)) {
+        endWait(waiter, ErrorCode::RESOURCE_NOT_AVAILABLE);
+    }
+    return waiter.result;
+}
+
+void ResourceManager::cancelWait(ProcessID pid) {
+    std::lock_guard<std::mutex> lock(resource_mutex_);
+    if (Waiter* waiter = findWaiter(pid)) {
+        endWait(*waiter, ErrorCode::OPERATION_FAILED);
+    }
+}
+
+void ResourceManager::grant(ProcessID pid, ResourceID resource_id) {
+    allocations_[resource_id] = pid;
+    process_resources_[pid].push_back(resource_id);
+}
+
+ErrorCode ResourceManager::giveBack(ProcessID pid, ResourceID resource_id) {
     // Check if resource is allocated to this process
     auto it = allocations_.find(resource_id);
     if (it == allocations_.end() || it->second != pid) {
         return ErrorCode::RESOURCE_NOT_AVAILABLE;
     }
     
-    // Release the resource
-    allocations_.erase(resource_id);
-    
     // Remove from process resources
     auto& resources = process_resources_[pid];
     resources.erase(
         std::remove(resources.begin(), resources.end(), resource_id),
         resources.end()
     );
-    
+
+    // Straight to the longest waiter, so nobody can take it in between
+    auto queue = wait_queues_.find(resource_id);
+    if (queue == wait_queues_.end()) {
+        allocations_.erase(it);
+        return ErrorCode::SUCCESS;
+    }
+    Waiter& next = *queue->second.front();
+    it->second = next.pid;
+    process_resources_[next.pid].push_back(resource_id);
+    endWait(next, ErrorCode::SUCCESS);
     return ErrorCode::SUCCESS;
 }
 
+ResourceManager::Waiter* ResourceManager::findWaiter(ProcessID pid) const {
+    auto edge = waiting_for_.find(pid);
+    if (edge == waiting_for_.end()) {
+        return nullptr;
+    }
+    for (Waiter* waiter : wait_queues_.at(edge->second)) {
+        if (waiter->pid == pid) {
+            return waiter;
+        }
+    }
+    return nullptr;
+}
+
+void ResourceManager::endWait(Waiter& waiter, ErrorCode result) {
+    auto edge = waiting_for_.find(waiter.pid);
+    auto queue = wait_queues_.find(edge->second);
+    queue->second.erase(std::find(queue->second.begin(), queue->second.end(), &waiter));
+    if (queue->second.empty()) {
+        wait_queues_.erase(queue);
+    }
+    waiting_for_.erase(edge);
+
+    waiter.result = result;
+    waiter.done = true;
+    waiter.cv.notify_one();
+}
+
+ErrorCode ResourceManager::setResourceUnits(ResourceType type, ResourceUnits total) {
+    std::lock_guard<std::mutex> lock(resource_mutex_);
+    return units_.setTotal(static_cast<size_t>(type), total);
+}
+
+ErrorCode ResourceManager::declareMaxClaim(ProcessID pid,
+                                           const std::vector<ResourceUnits>& claim) {
+    std::lock_guard<std::mutex> lock(resource_mutex_);
+    return units_.declareClaim(pid, claim);
+}
+
+ErrorCode ResourceManager::allocate(ProcessID pid, ResourceType type, ResourceUnits units) {
+    std::lock_guard<std::mutex> lock(resource_mutex_);
+    return units_.allocate(pid, static_cast<size_t>(type), units);
+}
+
+ErrorCode ResourceManager::release(ProcessID pid, ResourceType type, ResourceUnits units) {
+    std::lock_guard<std::mutex> lock(resource_mutex_);
+    return units_.release(pid, static_cast<size_t>(type), units);
+}
+
+void ResourceManager::releaseAllUnits(ProcessID pid) {
+    std::lock_guard<std::mutex> lock(resource_mutex_);
+    units_.releaseAll(pid);
+}
+
+ResourceUnits ResourceManager::getTotalUnits(ResourceType type) const {
+    std::lock_guard<std::mutex> lock(resource_mutex_);
+    return units_.getTotal(static_cast<size_t>(type));
+}
+
+ResourceUnits ResourceManager::getAvailableUnits(ResourceType type) const {
+    std::lock_guard<std::mutex> lock(resource_mutex_);
+    return units_.getAvailable(static_cast<size_t>(type));
+}
+
+ResourceUnits ResourceManager::getAllocatedUnits(ProcessID pid, ResourceType type) const {
+    std::lock_guard<std::mutex> lock(resource_mutex_);
+    return units_.getAllocated(pid, static_cast<size_t>(type));
+}
+
 bool ResourceManager::isResourceAvailable(ResourceID resource_id) const {
     std::lock_guard<std::mutex> lock(resource_mutex_);
     return resources_.find(resource_id) != resources_.end() &&
@@ -150,15 +277,28 @@ bool ResourceManager::isResourceAvailable(ResourceID resource_id) const {
 
 std::vector<ResourceID> ResourceManager::getAvailableResources() const {
     std::lock_guard<std::mutex> lock(resource_mutex_);
-    std::vector<ResourceID> available;
-    
-    for (const auto& [id, _] : resources_) {
-        if (allocations_.find(id) == allocations_.end()) {
-            available.push_back(id);
+
+    auto collect = [this](size_t first, size_t last, std::vector<ResourceID> available) {
+        for (size_t bucket = first; bucket < last; ++bucket) {
+            for (auto it = resources_.begin(bucket); it != resources_.end(bucket); ++it) {
+                if (allocations_.find(it->first) == allocations_.end()) {
+                    available.push_back(it->first);
+                }
+            }
         }
+        return available;
+    };
+
+    ThreadPool* pool = thread_pool_.load();
+    if (pool && resources_.size() >= kParallelSweepThreshold) {
+        return pool->parallelReduce(0, resources_.bucket_count(), 0, std::vector<ResourceID>{},
+            collect,
+            [](std::vector<ResourceID> lhs, const std::vector<ResourceID>& rhs) {
+                lhs.insert(lhs.end(), rhs.begin(), rhs.end());
+                return lhs;
+            });
     }
-    
-    return available;
+    return collect(0, resources_.bucket_count(), std::vector<ResourceID>{});
 }
 
 std::vector<ResourceID> ResourceManager::getProcessResources(ProcessID pid) const {
@@ -169,61 +309,58 @@ std::vector<ResourceID> ResourceManager::getProcessResources(ProcessID pid) cons
 
 bool ResourceManager::detectDeadlock() {
     std::lock_guard<std::mutex> lock(resource_mutex_);
-    std::vector<bool> visited(next_resource_id_, false);
-    std::vector<bool> rec_stack(next_resource_id_, false);
-    
-    for (const auto& [pid, _] : process_resources_) {
-        if (hasCycle(visited, rec_stack, pid)) {
-            return true;
-        }
+    return !findCycle().empty();
+}
+
+std::vector<ProcessID> ResourceManager::findCycle() const {
+    // Indexed by pid; pids are recycled lowest first, so this stays close
+    // to the number of live processes
+    ProcessID highest_pid = -1;
+    for (const auto& [rid, pid] : allocations_) {
+        highest_pid = std::max(highest_pid, pid);
     }
-    
-    return false;
-}
-
-bool ResourceManager::hasCycle(std::vector<bool>& visited, 
-                             std::vector<bool>& rec_stack, 
-                             ProcessID pid) {
-    if (!visited[pid]) {
-        visited[pid] = true;
-        rec_stack[pid] = true;
-        
-        // Check resources this process is waiting for
-        const auto& resources = process_resources_[pid];
-        for (ResourceID res_id : resources) {
-            auto alloc_it = allocations_.find(res_id);
-            if (alloc_it != allocations_.end()) {
-                ProcessID next_pid = alloc_it->second;
-                if (!visited[next_pid] && hasCycle(visited, rec_stack, next_pid)) {
-                    return true;
-                } else if (rec_stack[next_pid]) {
-                    return true;
-                }
+    for (const auto& [pid, rid] : waiting_for_) {
+        highest_pid = std::max(highest_pid, pid);
+    }
+
+    // A waiting process has one edge, to the holder of its resource, so a
+    // walk from any process either stops or comes back to a process it
+    // passed; walks are numbered so later ones stop on earlier trails
+    std::vector<size_t> walk_of(static_cast<size_t>(highest_pid + 1), 0);
+    size_t walk = 0;
+    for (const auto& [start, _] : waiting_for_) {
+        ++walk;
+        ProcessID pid = start;
+        while (walk_of[pid] == 0) {
+            walk_of[pid] = walk;
+            auto edge = waiting_for_.find(pid);
+            if (edge == waiting_for_.end()) {
+                break;
             }
+            pid = allocations_.at(edge->second);
+        }
+        if (walk_of[pid] != walk || waiting_for_.count(pid) == 0) {
+            continue;
         }
+
+        // Back on this walk's own trail: pid is on a cycle
+        std::vector<ProcessID> cycle{pid};
+        for (ProcessID next = allocations_.at(waiting_for_.at(pid)); next != pid;
+             next = allocations_.at(waiting_for_.at(next))) {
+            cycle.push_back(next);
+        }
+        return cycle;
     }
-    
-    rec_stack[pid] = false;
-    return false;
+    return {};
 }
 
 void ResourceManager::resolveDeadlock() {
     std::lock_guard<std::mutex> lock(resource_mutex_);
-    
-    if (process_resources_.empty()) {
-        return;
-    }
-    
-    // Find process with highest PID
-    ProcessID highest_pid = 0;
-    for (const auto& [pid, _] : process_resources_) {
-        highest_pid = std::max(highest_pid, pid);
-    }
-    
-    // Release all its resources
-    auto resources = process_resources_[highest_pid];
-    for (ResourceID res_id : resources) {
-        releaseResource(highest_pid, res_id);
+
+    // Failing one wait per cycle breaks it; the victim keeps what it holds
+    for (auto cycle = findCycle(); !cycle.empty(); cycle = findCycle()) {
+        ProcessID victim = *std::max_element(cycle.begin(), cycle.end());
+        endWait(*findWaiter(victim), ErrorCode::DEADLOCK_DETECTED);
     }
 }
 
@@ -237,4 +374,8 @@ size_t ResourceManager::getAllocatedResourceCount() const {
     return allocations_.size();
 }
 
+void ResourceManager::setThreadPool(ThreadPool* pool) {
+    thread_pool_ = pool;
+}
+
 } // namespace os_sim
\ No newline at end of file
@@ -0,0 +1,268 @@
+// src/resource/resource_pool.cpp
+#include "resource/resource_pool.hpp"
+#include <algorithm>
+
+namespace os_sim {
+
+ResourcePool::ResourcePool(size_t classes)
+    : total_(classes, 0), available_(classes, 0), need_total_(classes, 0),
+      allocation_(classes), need_(classes) {}
+
+ErrorCode ResourcePool::setTotal(size_t resource_class, ResourceUnits units) {
+    if (resource_class >= getClassCount()) {
+        return ErrorCode::RESOURCE_NOT_FOUND;
+    }
+    ResourceUnits held = total_[resource_class] - available_[resource_class];
+    if (units < held) {
+        return ErrorCode::INVALID_STATE;
+    }
+
+    ResourceUnits old_total = total_[resource_class];
+    total_[resource_class] = units;
+    available_[resource_class] = units - held;
+    // Growing only adds work, so only a shrink can leave the state unsafe
+    if (units < old_total && !isSafe()) {
+        total_[resource_class] = old_total;
+        available_[resource_class] = old_total - held;
+        return ErrorCode::DEADLOCK_DETECTED;
+    }
+    return ErrorCode::SUCCESS;
+}
+
+ErrorCode ResourcePool::declareClaim(ProcessID pid, const std::vector<ResourceUnits>& claim) {
+    if (claim.size() != getClassCount()) {
+        return ErrorCode::OPERATION_FAILED;
+    }
+    for (size_t c = 0; c < claim.size(); ++c) {
+        if (claim[c] > total_[c]) {
+            return ErrorCode::RESOURCE_NOT_AVAILABLE;
+        }
+    }
+
+    bool existed = row_of_.count(pid) != 0;
+    size_t row = rowFor(pid);
+    for (size_t c = 0; c < claim.size(); ++c) {
+        if (allocation_[c][row] > claim[c]) {
+            return ErrorCode::INVALID_STATE;
+        }
+    }
+
+    std::vector<ResourceUnits> old_need(claim.size());
+    bool grew = false;
+    for (size_t c = 0; c < claim.size(); ++c) {
+        old_need[c] = need_[c][row];
+        ResourceUnits need = claim[c] - allocation_[c][row];
+        grew |= need > old_need[c];
+        need_total_[c] += need;
+        need_total_[c] -= old_need[c];
+        need_[c][row] = need;
+    }
+    uint8_t was_claimed = claimed_[row];
+    claimed_[row] = 1;
+
+    // Lowering a claim cannot make a safe state unsafe
+    if (grew && !isSafe()) {
+        for (size_t c = 0; c < claim.size(); ++c) {
+            need_total_[c] -= need_[c][row];
+            need_total_[c] += old_need[c];
+            need_[c][row] = old_need[c];
+        }
+        claimed_[row] = was_claimed;
+        if (!existed) {
+            removeRow(row);
+        }
+        return ErrorCode::DEADLOCK_DETECTED;
+    }
+    return ErrorCode::SUCCESS;
+}
+
+ErrorCode ResourcePool::allocate(ProcessID pid, size_t resource_class, ResourceUnits units) {
+    if (resource_class >= getClassCount()) {
+        return ErrorCode::RESOURCE_NOT_FOUND;
+    }
+    if (units > available_[resource_class]) {
+        return ErrorCode::RESOURCE_NOT_AVAILABLE;
+    }
+    if (units == 0) {
+        return ErrorCode::SUCCESS;
+    }
+
+    auto it = row_of_.find(pid);
+    if (it != row_of_.end() && claimed_[it->second] &&
+        units > need_[resource_class][it->second]) {
+        return ErrorCode::OPERATION_FAILED;
+    }
+
+    bool existed = it != row_of_.end();
+    size_t row = existed ? it->second : rowFor(pid);
+    grant(row, resource_class, units);
+    if (!staysSafe(row)) {
+        revoke(row, resource_class, units);
+        if (!existed) {
+            removeRow(row);
+        }
+        return ErrorCode::DEADLOCK_DETECTED;
+    }
+    return ErrorCode::SUCCESS;
+}
+
+ErrorCode ResourcePool::release(ProcessID pid, size_t resource_class, ResourceUnits units) {
+    if (resource_class >= getClassCount()) {
+        return ErrorCode::RESOURCE_NOT_FOUND;
+    }
+    auto it = row_of_.find(pid);
+    if (it == row_of_.end() || allocation_[resource_class][it->second] < units) {
+        return ErrorCode::RESOURCE_NOT_AVAILABLE;
+    }
+
+    // Giving units back never makes a safe state unsafe
+    size_t row = it->second;
+    revoke(row, resource_class, units);
+    if (!claimed_[row]) {
+        bool holds = false;
+        for (const auto& column : allocation_) {
+            holds |= column[row] != 0;
+        }
+        if (!holds) {
+            removeRow(row);
+        }
+    }
+    return ErrorCode::SUCCESS;
+}
+
+void ResourcePool::releaseAll(ProcessID pid) {
+    auto it = row_of_.find(pid);
+    if (it == row_of_.end()) {
+        return;
+    }
+    size_t row = it->second;
+    for (size_t c = 0; c < getClassCount(); ++c) {
+        available_[c] += allocation_[c][row];
+        need_total_[c] -= need_[c][row];
+    }
+    removeRow(row);
+}
+
+ResourceUnits ResourcePool::getAllocated(ProcessID pid, size_t resource_class) const {
+    auto it = row_of_.find(pid);
+    return it != row_of_.end() ? allocation_[resource_class][it->second] : 0;
+}
+
+ResourceUnits ResourcePool::getNeed(ProcessID pid, size_t resource_class) const {
+    auto it = row_of_.find(pid);
+    return it != row_of_.end() ? need_[resource_class][it->second] : 0;
+}
+
+bool ResourcePool::isSafe() const {
+    // Every process whose need fits the work finishes in the same round,
+    // since finishing only adds to the work; each round is a pass over
+    // the columns with no data-dependent branches
+    size_t rows = pids_.size();
+    finished_.assign(rows, 0);
+    runnable_.resize(rows);
+    work_.assign(available_.begin(), available_.end());
+
+    for (size_t remaining = rows; remaining > 0;) {
+        for (size_t r = 0; r < rows; ++r) {
+            runnable_[r] = finished_[r] ^ 1;
+        }
+        for (size_t c = 0; c < getClassCount(); ++c) {
+            const ResourceUnits* need = need_[c].data();
+            ResourceUnits work = work_[c];
+            for (size_t r = 0; r < rows; ++r) {
+                runnable_[r] &= need[r] <= work;
+            }
+        }
+
+        size_t count = 0;
+        for (size_t r = 0; r < rows; ++r) {
+            count += runnable_[r];
+        }
+        if (count == 0) {
+            return false;
+        }
+        if (count == remaining) {
+            return true;
+        }
+
+        for (size_t c = 0; c < getClassCount(); ++c) {
+            const ResourceUnits* allocation = allocation_[c].data();
+            // Bounded by the total, like the work it adds to
+            ResourceUnits freed = 0;
+            for (size_t r = 0; r < rows; ++r) {
+                freed += allocation[r] & (0u - runnable_[r]);
+            }
+            work_[c] += freed;
+        }
+        for (size_t r = 0; r < rows; ++r) {
+            finished_[r] |= runnable_[r];
+        }
+        remaining -= count;
+    }
+    return true;
+}
+
+size_t ResourcePool::rowFor(ProcessID pid) {
+    auto [it, inserted] = row_of_.emplace(pid, pids_.size());
+    if (inserted) {
+        pids_.push_back(pid);
+        claimed_.push_back(0);
+        for (size_t c = 0; c < getClassCount(); ++c) {
+            allocation_[c].push_back(0);
+            need_[c].push_back(0);
+        }
+    }
+    return it->second;
+}
+
+void ResourcePool::removeRow(size_t row) {
+    size_t last = pids_.size() - 1;
+    row_of_.erase(pids_[row]);
+    if (row != last) {
+        pids_[row] = pids_[last];
+        claimed_[row] = claimed_[last];
+        for (size_t c = 0; c < getClassCount(); ++c) {
+            allocation_[c][row] = allocation_[c][last];
+            need_[c][row] = need_[c][last];
+        }
+        row_of_[pids_[row]] = row;
+    }
+    pids_.pop_back();
+    claimed_.pop_back();
+    for (size_t c = 0; c < getClassCount(); ++c) {
+        allocation_[c].pop_back();
+        need_[c].pop_back();
+    }
+}
+
+void ResourcePool::grant(size_t row, size_t resource_class, ResourceUnits units) {
+    available_[resource_class] -= units;
+    allocation_[resource_class][row] += units;
+    if (claimed_[row]) {
+        need_[resource_class][row] -= units;
+        need_total_[resource_class] -= units;
+    }
+}
+
+void ResourcePool::revoke(size_t row, size_t resource_class, ResourceUnits units) {
+    available_[resource_class] += units;
+    allocation_[resource_class][row] -= units;
+    if (claimed_[row]) {
+        need_[resource_class][row] += units;
+        need_total_[resource_class] += units;
+    }
+}
+
+bool ResourcePool::staysSafe(size_t row) const {
+    // If row can still finish first it hands back at least what the
+    // grant took, after which the old safe order goes through unchanged
+    bool row_fits = true;
+    bool all_fit = true;
+    for (size_t c = 0; c < getClassCount(); ++c) {
+        row_fits &= need_[c][row] <= available_[c];
+        all_fit &= need_total_[c] <= available_[c];
+    }
+    return row_fits || all_fit || isSafe();
+}
+
+} // namespace os_sim
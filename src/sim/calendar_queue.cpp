@@ -0,0 +1,117 @@
+// src/sim/calendar_queue.cpp
+#include "sim/calendar_queue.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace os_sim {
+
+CalendarQueue::CalendarQueue()
+    : buckets_(kMinBuckets)
+{
+}
+
+void CalendarQueue::push(const Event& event) {
+    if (event.time < start_) {
+        moveTo(event.time);
+    }
+    insert(event);
+    ++size_;
+
+    if (size_ > 2 * buckets_.size()) {
+        resize(buckets_.size() * 2);
+    }
+}
+
+Event CalendarQueue::pop() {
+    ++pops_since_resize_;
+
+    // Scan at most one year for an event that falls in the bucket's range
+    bool found = false;
+    for (size_t scanned = 0; scanned < buckets_.size(); ++scanned) {
+        const auto& bucket = buckets_[current_];
+        if (!bucket.empty() && bucket.back().time < bucket_top_) {
+            found = true;
+            break;
+        }
+        current_ = (current_ + 1) & (buckets_.size() - 1);
+        bucket_top_ += width_;
+    }
+
+    if (!found) {
+        // Nothing due within a year: the width no longer matches the event
+        // spacing. Jump straight to the earliest event, and re-estimate the
+        // width if this keeps happening.
+        const Event* earliest = nullptr;
+        for (const auto& bucket : buckets_) {
+            if (!bucket.empty() && (!earliest || runsBefore(bucket.back(), *earliest))) {
+                earliest = &bucket.back();
+            }
+        }
+        moveTo(earliest->time);
+        if (pops_since_resize_ >= buckets_.size()) {
+            resize(buckets_.size());
+        }
+    }
+
+    auto& bucket = buckets_[current_];
+    Event event = bucket.back();
+    bucket.pop_back();
+    --size_;
+    start_ = event.time;
+
+    if (size_ < buckets_.size() / 2 && buckets_.size() > kMinBuckets) {
+        resize(buckets_.size() / 2);
+    }
+    return event;
+}
+
+void CalendarQueue::insert(const Event& event) {
+    auto& bucket = buckets_[bucketOf(event.time)];
+    auto position = std::lower_bound(
+        bucket.begin(), bucket.end(), event,
+        [](const Event& queued, const Event& value) { return runsBefore(value, queued); });
+    bucket.insert(position, event);
+}
+
+void CalendarQueue::moveTo(SimTime time) {
+    start_ = time;
+    current_ = bucketOf(time);
+    bucket_top_ = (time / width_ + 1) * width_;
+}
+
+void CalendarQueue::resize(size_t bucket_count) {
+    std::vector<Event> events;
+    events.reserve(size_);
+    for (const auto& bucket : buckets_) {
+        events.insert(events.end(), bucket.begin(), bucket.end());
+    }
+
+    // Brown's estimate: three times the average gap between the earliest
+    // events, leaving out gaps more than twice the plain average
+    size_t sample = std::min(events.size(), kWidthSample);
+    if (sample >= 2) {
+        std::partial_sort(events.begin(), events.begin() + sample, events.end(), runsBefore);
+        double average = static_cast<double>(events[sample - 1].time - events[0].time) /
+                         static_cast<double>(sample - 1);
+        double total = 0.0;
+        size_t gaps = 0;
+        for (size_t i = 1; i < sample; ++i) {
+            auto gap = static_cast<double>(events[i].time - events[i - 1].time);
+            if (gap <= 2.0 * average) {
+                total += gap;
+                ++gaps;
+            }
+        }
+        double width = gaps ? 3.0 * total / static_cast<double>(gaps) : 0.0;
+        width_ = std::max<SimTime>(1, static_cast<SimTime>(std::llround(width)));
+    }
+
+    buckets_.assign(bucket_count, {});
+    moveTo(start_);
+    for (const auto& event : events) {
+        insert(event);
+    }
+    pops_since_resize_ = 0;
+}
+
+} // namespace os_sim
@@ -0,0 +1,67 @@
+// src/sim/event_engine.cpp
+#include "sim/event_engine.hpp"
+#include <algorithm>
+
+namespace os_sim {
+
+EventEngine::EventEngine(Handler handler)
+    : handler_(std::move(handler))
+{
+}
+
+uint64_t EventEngine::schedule(SimTime delay, EventType type, int32_t pid,
+                               int32_t target, uint64_t arg) {
+    SimTime time = delay > kForever - now_ ? kForever : now_ + delay;
+    return scheduleAt(time, type, pid, target, arg);
+}
+
+uint64_t EventEngine::scheduleAt(SimTime time, EventType type, int32_t pid,
+                                 int32_t target, uint64_t arg) {
+    Event event;
+    event.time = std::max(time, now_);
+    event.sequence = next_sequence_++;
+    event.type = type;
+    event.pid = pid;
+    event.target = target;
+    event.arg = arg;
+    queue_.push(event);
+    return event.sequence;
+}
+
+bool EventEngine::step() {
+    if (queue_.empty()) {
+        return false;
+    }
+
+    Event event = queue_.pop();
+    now_ = event.time;
+    ++processed_;
+    if (handler_) {
+        handler_(event);
+    }
+    return true;
+}
+
+uint64_t EventEngine::run(SimTime until) {
+    uint64_t handled = 0;
+    while (!queue_.empty()) {
+        Event event = queue_.pop();
+        if (event.time > until) {
+            // Put it back; it keeps its sequence number and thus its place
+            queue_.push(event);
+            break;
+        }
+        now_ = event.time;
+        ++processed_;
+        ++handled;
+        if (handler_) {
+            handler_(event);
+        }
+    }
+    if (until != kForever) {
+        now_ = std::max(now_, until);
+    }
+    return handled;
+}
+
+} // namespace os_sim
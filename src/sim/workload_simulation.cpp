@@ -0,0 +1,316 @@
+// src/sim/workload_simulation.cpp
+#include "sim/workload_simulation.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+
+namespace os_sim {
+
+WorkloadSimulation::WorkloadSimulation(SimulationConfig config)
+    : config_(std::move(config))
+    , random_state_(config_.seed)
+{
+    if (config_.cpus == 0) {
+        throw std::invalid_argument("Simulation needs at least one CPU");
+    }
+    config_.mean_bursts = std::max<size_t>(config_.mean_bursts, 1);
+    config_.quantum = std::max<SimTime>(config_.quantum, 1);
+
+    cpus_.resize(config_.cpus);
+    for (auto& cpu : cpus_) {
+        cpu.policy = makeSchedulerPolicy(config_.policy);
+        if (!cpu.policy) {
+            throw std::invalid_argument("Unknown scheduler policy: " + config_.policy);
+        }
+    }
+    resources_.resize(config_.resources);
+    processes_.reserve(config_.processes);
+    turnarounds_.reserve(config_.processes);
+
+    engine_.setHandler([this](const Event& event) { handle(event); });
+}
+
+SimulationResult WorkloadSimulation::run() {
+    auto start = std::chrono::steady_clock::now();
+
+    if (config_.processes > 0) {
+        engine_.scheduleAt(0, EventType::PROCESS_ARRIVAL, 0);
+    }
+    engine_.run();
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    result_.wall_seconds = elapsed.count();
+    result_.end_time = engine_.now();
+    result_.events = engine_.processed();
+
+    if (!turnarounds_.empty()) {
+        double total = 0.0;
+        for (SimTime turnaround : turnarounds_) {
+            total += static_cast<double>(turnaround);
+        }
+        result_.mean_turnaround_ms = total / turnarounds_.size() / 1e6;
+
+        size_t rank = std::min(turnarounds_.size() - 1, turnarounds_.size() * 99 / 100);
+        std::nth_element(turnarounds_.begin(), turnarounds_.begin() + rank, turnarounds_.end());
+        result_.p99_turnaround_ms = turnarounds_[rank] / 1e6;
+    }
+    if (result_.dispatches > 0) {
+        result_.mean_ready_wait_ms =
+            static_cast<double>(total_ready_wait_) / result_.dispatches / 1e6;
+    }
+    if (result_.end_time > 0) {
+        SimTime busy = 0;
+        for (const auto& cpu : cpus_) {
+            busy += cpu.busy;
+        }
+        result_.cpu_utilization = static_cast<double>(busy) /
+                                  (static_cast<double>(result_.end_time) * cpus_.size());
+    }
+    return result_;
+}
+
+void WorkloadSimulation::handle(const Event& event) {
+    switch (event.type) {
+        case EventType::PROCESS_ARRIVAL:
+            onArrival(event.pid);
+            break;
+        case EventType::SLICE_END:
+            onSliceEnd(event.pid, event.arg);
+            break;
+        case EventType::IO_COMPLETE:
+            onIoComplete(event.pid);
+            break;
+        case EventType::RESOURCE_REQUEST:
+            onResourceRequest(event.pid, event.target);
+            break;
+        case EventType::MESSAGE_DELIVER:
+            onMessage(event.target);
+            break;
+        default:
+            break;
+    }
+}
+
+void WorkloadSimulation::onArrival(int32_t pid) {
+    processes_.emplace_back();
+    SimProcess& process = processes_.back();
+    process.priority = static_cast<Priority>(
+        nextRandom() % (static_cast<uint64_t>(std::max<Priority>(config_.max_priority, 0)) + 1));
+    process.arrival = engine_.now();
+    process.bursts_left = static_cast<uint32_t>(1 + nextRandom() % (2 * config_.mean_bursts - 1));
+    process.cpu = static_cast<uint32_t>(leastLoadedCpu());
+
+    if (static_cast<size_t>(pid) + 1 < config_.processes) {
+        engine_.schedule(exponential(config_.mean_interarrival),
+                         EventType::PROCESS_ARRIVAL, pid + 1);
+    }
+    beginBurst(pid);
+}
+
+void WorkloadSimulation::onSliceEnd(int32_t pid, SimTime slice) {
+    SimProcess& process = processes_[pid];
+    SimCpu& cpu = cpus_[process.cpu];
+    cpu.busy += slice;
+    process.burst_left -= slice;
+
+    bool expired = cpu.policy->tick(pid);
+    if (process.burst_left == 0) {
+        finishBurst(pid);
+        return;
+    }
+    if (!expired) {
+        startSlice(pid);
+        return;
+    }
+
+    // Preempted: back into the run queue, then let the policy choose
+    process.state = ProcessState::READY;
+    process.ready_since = engine_.now();
+    cpu.policy->enqueue(pid, process.priority);
+    ++cpu.ready;
+    cpu.running = -1;
+    dispatch(process.cpu);
+}
+
+void WorkloadSimulation::onIoComplete(int32_t pid) {
+    beginBurst(pid);
+}
+
+void WorkloadSimulation::onResourceRequest(int32_t pid, int32_t resource) {
+    SimResource& slot = resources_[resource];
+    if (slot.holder < 0) {
+        slot.holder = pid;
+        processes_[pid].resource = resource;
+        makeReady(pid);
+    } else {
+        ++result_.resource_waits;
+        slot.waiters.push_back(pid);
+    }
+}
+
+void WorkloadSimulation::onMessage(int32_t receiver) {
+    if (processes_[receiver].state == ProcessState::TERMINATED) {
+        ++result_.messages_dropped;
+    } else {
+        ++result_.messages_delivered;
+    }
+}
+
+void WorkloadSimulation::beginBurst(int32_t pid) {
+    SimProcess& process = processes_[pid];
+    process.burst_left = exponential(config_.mean_burst);
+
+    if (!resources_.empty() && uniform() < config_.resource_probability) {
+        process.state = ProcessState::WAITING;
+        auto resource = static_cast<int32_t>(nextRandom() % resources_.size());
+        engine_.schedule(0, EventType::RESOURCE_REQUEST, pid, resource);
+    } else {
+        makeReady(pid);
+    }
+}
+
+void WorkloadSimulation::makeReady(int32_t pid) {
+    SimProcess& process = processes_[pid];
+
+    // Wake onto an idle CPU rather than queue behind a busy home CPU
+    if (cpus_[process.cpu].running >= 0) {
+        for (size_t i = 0; i < cpus_.size(); ++i) {
+            if (cpus_[i].running < 0 && cpus_[i].ready == 0) {
+                cpus_[process.cpu].policy->forget(pid);
+                process.cpu = static_cast<uint32_t>(i);
+                ++result_.migrations;
+                break;
+            }
+        }
+    }
+
+    SimCpu& cpu = cpus_[process.cpu];
+    process.state = ProcessState::READY;
+    process.ready_since = engine_.now();
+    cpu.policy->enqueue(pid, process.priority);
+    ++cpu.ready;
+    if (cpu.running < 0) {
+        dispatch(process.cpu);
+    }
+}
+
+void WorkloadSimulation::dispatch(size_t index) {
+    SimCpu& cpu = cpus_[index];
+
+    std::optional<ProcessID> next = cpu.policy->pickNext();
+    if (next) {
+        --cpu.ready;
+    } else {
+        // Idle: pull the policy's choice from the longest run queue
+        size_t busiest = index;
+        for (size_t i = 0; i < cpus_.size(); ++i) {
+            if (cpus_[i].ready > cpus_[busiest].ready) {
+                busiest = i;
+            }
+        }
+        if (cpus_[busiest].ready == 0) {
+            cpu.running = -1;
+            return;
+        }
+        SimCpu& source = cpus_[busiest];
+        next = source.policy->pickNext();
+        --source.ready;
+        source.policy->forget(*next);
+        processes_[*next].cpu = static_cast<uint32_t>(index);
+        cpu.policy->updatePriority(*next, processes_[*next].priority);
+        ++result_.migrations;
+    }
+
+    SimProcess& process = processes_[*next];
+    process.state = ProcessState::RUNNING;
+    cpu.running = *next;
+    total_ready_wait_ += engine_.now() - process.ready_since;
+    ++result_.dispatches;
+    startSlice(*next);
+}
+
+void WorkloadSimulation::startSlice(int32_t pid) {
+    SimProcess& process = processes_[pid];
+    SimTime slice = std::min(config_.quantum, process.burst_left);
+    engine_.schedule(slice, EventType::SLICE_END, pid, static_cast<int32_t>(process.cpu), slice);
+}
+
+void WorkloadSimulation::finishBurst(int32_t pid) {
+    SimProcess& process = processes_[pid];
+    size_t cpu = process.cpu;
+    releaseResource(pid);
+
+    --process.bursts_left;
+    if (processes_.size() > 1 && uniform() < config_.message_probability) {
+        // Peers are among the most recent arrivals
+        size_t peers = std::min<size_t>(processes_.size(), kMessagePeers);
+        auto receiver = static_cast<int32_t>(processes_.size() - 1 - nextRandom() % peers);
+        engine_.schedule(config_.message_latency, EventType::MESSAGE_DELIVER, pid, receiver);
+    }
+
+    if (process.bursts_left == 0) {
+        process.state = ProcessState::TERMINATED;
+        cpus_[cpu].policy->forget(pid);
+        turnarounds_.push_back(engine_.now() - process.arrival);
+        ++result_.completed;
+    } else {
+        process.state = ProcessState::WAITING;
+        engine_.schedule(exponential(config_.mean_io), EventType::IO_COMPLETE, pid);
+    }
+
+    cpus_[cpu].running = -1;
+    dispatch(cpu);
+}
+
+void WorkloadSimulation::releaseResource(int32_t pid) {
+    SimProcess& process = processes_[pid];
+    if (process.resource < 0) {
+        return;
+    }
+
+    // Hand the resource straight to the first waiter
+    SimResource& slot = resources_[process.resource];
+    process.resource = -1;
+    if (slot.waiters.empty()) {
+        slot.holder = -1;
+        return;
+    }
+    int32_t next = slot.waiters.front();
+    slot.waiters.pop_front();
+    slot.holder = next;
+    processes_[next].resource = static_cast<int32_t>(&slot - resources_.data());
+    makeReady(next);
+}
+
+size_t WorkloadSimulation::leastLoadedCpu() const {
+    size_t best = 0;
+    size_t best_load = SIZE_MAX;
+    for (size_t i = 0; i < cpus_.size(); ++i) {
+        size_t load = cpus_[i].ready + (cpus_[i].running >= 0 ? 1 : 0);
+        if (load < best_load) {
+            best = i;
+            best_load = load;
+        }
+    }
+    return best;
+}
+
+uint64_t WorkloadSimulation::nextRandom() {
+    // splitmix64
+    uint64_t z = (random_state_ += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+double WorkloadSimulation::uniform() {
+    return static_cast<double>(nextRandom() >> 11) * 0x1.0p-53;
+}
+
+SimTime WorkloadSimulation::exponential(SimTime mean) {
+    double sample = -std::log(1.0 - uniform()) * static_cast<double>(mean);
+    return std::max<SimTime>(1, static_cast<SimTime>(std::llround(sample)));
+}
+
+} // namespace os_sim
@@ -3,25 +3,60 @@
 #include "process/process.hpp"
 #include "process/process_manager.hpp"
 #include "resource/resource_manager.hpp"
+#include "sim/workload_simulation.hpp"
+#include "thread/task_graph.hpp"
 #include "thread/thread_pool.hpp"
 #include <iostream>
 #include <sstream>
 #include <iomanip>
 #include <chrono>
+#include <algorithm>
+#include <cctype>
+#include <thread>
 
 extern void parseAndCalculate(const std::string& input);
 extern void calculatorFunction();
 
 namespace os_sim {
 
+namespace {
+
+// Accepts the names toString prints, in any case
+bool parseResourceType(std::string name, ResourceType& type) {
+    std::transform(name.begin(), name.end(), name.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+    for (size_t i = 0; i < kResourceTypeCount; ++i) {
+        if (name == toString(static_cast<ResourceType>(i))) {
+            type = static_cast<ResourceType>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
 Simulator& Simulator::getInstance() {
     static Simulator instance;
     return instance;
 }
 
+void Simulator::setWorkerAffinity(AffinityPolicy policy, std::vector<int> cpus) {
+    worker_affinity_ = policy;
+    worker_cpus_ = std::move(cpus);
+}
+
 void Simulator::initialize() {
     // Initialize thread pool
-    thread_pool_ = std::make_unique<ThreadPool>(4);
+    ThreadPoolConfig pool_config;
+    pool_config.min_threads = 2;
+    pool_config.max_threads = std::max<size_t>(4, std::thread::hardware_concurrency());
+    pool_config.affinity = worker_affinity_;
+    pool_config.cpu_list = worker_cpus_;
+    thread_pool_ = std::make_unique<ThreadPool>(pool_config);
+    ProcessManager::getInstance().setThreadPool(thread_pool_.get());
+    ProcessManager::getInstance().setCpuCount(simulated_cpus_);
+    ResourceManager::getInstance().setThreadPool(thread_pool_.get());
     
     // Setup command handlers
     setupCommandHandlers();
@@ -49,9 +84,9 @@ void Simulator::run() {
 
 void Simulator::handleListProcesses() {
     auto& pm = ProcessManager::getInstance();
-    auto processes = pm.listProcesses();
+    auto snapshot = pm.getSnapshot();
     
-    if (processes.empty()) {
+    if (snapshot->size() == 0) {
         std::cout << "No active processes\n";
         return;
     }
@@ -63,14 +98,11 @@ void Simulator::handleListProcesses() {
               << "State\n";
     std::cout << std::string(50, '-') << "\n";
     
-    for (ProcessID pid : processes) {
-        auto process = pm.getProcess(pid);
-        if (process) {
-            std::cout << std::setw(5) << pid << " | "
-                      << std::setw(20) << process->getName() << " | "
-                      << std::setw(10) << process->getPriority() << " | "
-                      << toString(process->getState()) << "\n";
-        }
+    for (size_t row = 0; row < snapshot->size(); ++row) {
+        std::cout << std::setw(5) << snapshot->pids[row] << " | "
+                  << std::setw(20) << snapshot->names[row] << " | "
+                  << std::setw(10) << snapshot->priorities[row] << " | "
+                  << toString(snapshot->states[row]) << "\n";
     }
 }
 
@@ -94,8 +126,42 @@ void Simulator::handleSystemStatus() {
     
     // Process Information
     std::cout << "Active Processes: " << pm.getProcessCount() << "\n";
-    auto processes = pm.listProcesses();
-    if (!processes.empty()) {
+    std::cout << "Scheduler: " << pm.getSchedulerPolicy()
+              << " (" << pm.getReadyCount() << " ready)\n";
+
+    {
+        std::ios saved_format(nullptr);
+        saved_format.copyfmt(std::cout);
+
+        std::cout << "\nCPUs:\n";
+        std::cout << std::setw(4) << "CPU" << " | "
+                  << std::setw(7) << "Running" << " | "
+                  << std::setw(5) << "Ready" << " | "
+                  << std::setw(6) << "Util %" << " | "
+                  << std::setw(10) << "Dispatches" << " | "
+                  << "Migrations in/out\n";
+        std::cout << std::string(70, '-') << "\n";
+
+        auto cpu_stats = pm.getCpuStats();
+        std::cout << std::fixed << std::setprecision(1);
+        for (size_t cpu = 0; cpu < cpu_stats.size(); ++cpu) {
+            const CpuStats& stats = cpu_stats[cpu];
+            uint64_t ticks = stats.busy_ticks + stats.idle_ticks;
+            double utilization = ticks ? 100.0 * stats.busy_ticks / ticks : 0.0;
+            std::cout << std::setw(4) << cpu << " | "
+                      << std::setw(7) << (stats.running < 0 ? std::string("-")
+                                                            : std::to_string(stats.running))
+                      << " | "
+                      << std::setw(5) << stats.ready << " | "
+                      << std::setw(6) << utilization << " | "
+                      << std::setw(10) << stats.dispatches << " | "
+                      << stats.migrations_in << "/" << stats.migrations_out << "\n";
+        }
+
+        std::cout.copyfmt(saved_format);
+    }
+    auto snapshot = pm.getSnapshot();
+    if (snapshot->size() > 0) {
         std::cout << "\nProcess Details:\n";
         std::cout << std::setw(5) << "PID" << " | "
                   << std::setw(20) << "Name" << " | "
@@ -104,21 +170,18 @@ void Simulator::handleSystemStatus() {
                   << "Resources\n";
         std::cout << std::string(70, '-') << "\n";
         
-        for (ProcessID pid : processes) {
-            auto process = pm.getProcess(pid);
-            if (process) {
-                std::cout << std::setw(5) << pid << " | "
-                          << std::setw(20) << process->getName() << " | "
-                          << std::setw(10) << process->getPriority() << " | "
-                          << std::setw(15) << toString(process->getState()) << " | ";
-                
-                // Show resources held by this process
-                auto resources = rm.getProcessResources(pid);
-                for (auto res_id : resources) {
-                    std::cout << res_id << " ";
-                }
-                std::cout << "\n";
+        for (size_t row = 0; row < snapshot->size(); ++row) {
+            std::cout << std::setw(5) << snapshot->pids[row] << " | "
+                      << std::setw(20) << snapshot->names[row] << " | "
+                      << std::setw(10) << snapshot->priorities[row] << " | "
+                      << std::setw(15) << toString(snapshot->states[row]) << " | ";
+            
+            // Show resources held by this process
+            for (size_t i = snapshot->resource_offsets[row];
+                 i < snapshot->resource_offsets[row + 1]; ++i) {
+                std::cout << snapshot->resources[i] << " ";
             }
+            std::cout << "\n";
         }
     }
     
@@ -134,6 +197,95 @@ void Simulator::handleSystemStatus() {
     }
     std::cout << "\n";
     
+    // Thread pool information
+    if (thread_pool_) {
+        static const std::pair<TaskPriority, const char*> lanes[] = {
+            {TaskPriority::INTERACTIVE, "interactive"},
+            {TaskPriority::NORMAL, "normal"},
+            {TaskPriority::BACKGROUND, "background"},
+        };
+
+        ThreadPoolMetrics metrics = thread_pool_->getMetrics();
+
+        std::cout << "\nThread Pool:\n";
+        std::cout << "Workers: " << metrics.workers << " (min "
+                  << thread_pool_->getConfig().min_threads << ", max "
+                  << thread_pool_->getConfig().max_threads << ")\n";
+        std::cout << "Active Threads: " << metrics.active_threads << "\n";
+        std::cout << "Queued Tasks: " << metrics.queued_tasks << "\n";
+        std::cout << "Completed Tasks: " << metrics.completed_tasks
+                  << " (failed " << metrics.failed_tasks
+                  << ", stolen " << metrics.stolen_tasks << ")\n";
+        std::cout << "Pending Timers: " << thread_pool_->getPendingTimerCount()
+                  << " (dropped " << metrics.dropped_timer_tasks << ")\n";
+
+        std::ios saved_format(nullptr);
+        saved_format.copyfmt(std::cout);
+
+        std::cout << std::setw(12) << "Latency (us)" << " | "
+                  << std::setw(8) << "Mean" << " | "
+                  << std::setw(8) << "p50" << " | "
+                  << std::setw(8) << "p99" << " | "
+                  << std::setw(8) << "p99.9" << " | "
+                  << std::setw(8) << "Max" << "\n";
+        std::cout << std::string(70, '-') << "\n";
+        const std::pair<const char*, const LatencySummary*> latencies[] = {
+            {"queue wait", &metrics.queue_wait},
+            {"execution", &metrics.execution},
+        };
+        std::cout << std::fixed << std::setprecision(1);
+        for (const auto& [name, summary] : latencies) {
+            std::cout << std::setw(12) << name << " | "
+                      << std::setw(8) << summary->mean / 1000.0 << " | "
+                      << std::setw(8) << summary->p50 / 1000.0 << " | "
+                      << std::setw(8) << summary->p99 / 1000.0 << " | "
+                      << std::setw(8) << summary->p999 / 1000.0 << " | "
+                      << std::setw(8) << summary->max / 1000.0 << "\n";
+        }
+        std::cout << "\n";
+        std::cout.copyfmt(saved_format);
+
+        std::cout << std::setw(12) << "Lane" << " | "
+                  << std::setw(8) << "Queued" << " | "
+                  << std::setw(10) << "Completed" << " | "
+                  << std::setw(12) << "Avg Wait" << " | "
+                  << "Missed Deadlines\n";
+        std::cout << std::string(70, '-') << "\n";
+
+        for (const auto& [priority, name] : lanes) {
+            auto lane = thread_pool_->getLaneStats(priority);
+            std::cout << std::setw(12) << name << " | "
+                      << std::setw(8) << lane.queued_tasks << " | "
+                      << std::setw(10) << lane.completed_tasks << " | "
+                      << std::setw(10) << std::fixed << std::setprecision(3)
+                      << lane.average_wait_time << "ms | "
+                      << lane.missed_deadlines << "\n";
+        }
+        std::cout.copyfmt(saved_format);
+
+        std::cout << "\nWorker Placement:\n";
+        std::cout << std::setw(8) << "Worker" << " | "
+                  << std::setw(6) << "CPU" << " | "
+                  << std::setw(6) << "Node" << " | "
+                  << "State\n";
+        std::cout << std::string(40, '-') << "\n";
+        for (const auto& placement : thread_pool_->getWorkerPlacement()) {
+            if (!placement.running) {
+                continue;
+            }
+            std::cout << std::setw(8) << placement.worker << " | ";
+            if (placement.cpu >= 0) {
+                std::cout << std::setw(6) << placement.cpu << " | "
+                          << std::setw(6) << placement.node << " | "
+                          << (placement.pinned ? "pinned" : "pin failed") << "\n";
+            } else {
+                std::cout << std::setw(6) << "any" << " | "
+                          << std::setw(6) << "-" << " | "
+                          << "unpinned\n";
+            }
+        }
+    }
+
     // Check for deadlocks
     if (rm.detectDeadlock()) {
         std::cout << "\nWARNING: Deadlock detected in the system!\n";
@@ -160,6 +312,8 @@ void Simulator::processCommand(const std::string& command) {
     auto it = command_handlers_.find(cmd);
     if (it != command_handlers_.end()) {
         try {
+            // Runs on the command thread; a handler that waits must never
+            // hold a pool worker the rest of the prompt depends on
             it->second(args);
         } catch (const std::exception& e) {
             std::cerr << "Error: " << e.what() << std::endl;
@@ -172,14 +326,25 @@ void Simulator::processCommand(const std::string& command) {
 void Simulator::shutdown() {
     std::cout << "Shutting down simulator...\n";
     
-    if (thread_pool_) {
-        thread_pool_->shutdown();
-    }
-    
+    // Terminating first ends any acquire still waiting
     auto& pm = ProcessManager::getInstance();
+    if (event_subscriber_ >= 0) {
+        pm.getEventBus().unsubscribe(event_subscriber_);
+        event_subscriber_ = -1;
+    }
     for (ProcessID pid : pm.listProcesses()) {
         pm.terminateProcess(pid);
     }
+    for (auto& waiter : waiters_) {
+        waiter.join();
+    }
+    waiters_.clear();
+
+    if (thread_pool_) {
+        ProcessManager::getInstance().setThreadPool(nullptr);
+        ResourceManager::getInstance().setThreadPool(nullptr);
+        thread_pool_->shutdown();
+    }
     
     std::cout << "Simulator shutdown complete.\n";
 }
@@ -203,44 +368,83 @@ void Simulator::setupCommandHandlers() {
     command_handlers_["list"] = [this](const auto& /*args*/) { handleListProcesses(); };
     command_handlers_["info"] = [this](const auto& args) { handleProcessInfo(args); };
     command_handlers_["allocate"] = [this](const auto& args) { handleAllocateResource(args); };
+    command_handlers_["acquire"] = [this](const auto& args) { handleAcquireResource(args); };
     command_handlers_["release"] = [this](const auto& args) { handleReleaseResource(args); };
+    command_handlers_["units"] = [this](const auto& args) { handleResourceUnits(args); };
+    command_handlers_["claim"] = [this](const auto& args) { handleDeclareClaim(args); };
     command_handlers_["deadlock"] = [this](const auto& /*args*/) { handleCheckDeadlock(); };
     command_handlers_["status"] = [this](const auto& /*args*/) { handleSystemStatus(); };
     command_handlers_["resources"] = [this](const auto& /*args*/) { handleListResources(); };
     command_handlers_["suspend"] = [this](const auto& args) { handleSuspendProcess(args); };
     command_handlers_["resume"] = [this](const auto& args) { handleResumeProcess(args); };
     command_handlers_["calculator"] = [this](const auto& args) { handleStartCalculator(args); };
+    command_handlers_["policy"] = [this](const auto& args) { handleSchedulerPolicy(args); };
+    command_handlers_["schedule"] = [this](const auto& args) { handleRunScheduler(args); };
+    command_handlers_["simulate"] = [this](const auto& args) { handleSimulateWorkload(args); };
+    command_handlers_["events"] = [this](const auto& args) { handleEvents(args); };
+    command_handlers_["pipeline"] = [this](const auto& args) { handlePipeline(args); };
 }
 
 void Simulator::displayHelp() {
     std::cout << "\nAvailable commands:\n";
     std::cout << "  help                    - Display this help message\n";
     std::cout << "  create <name> [priority] - Create a new process\n";
+    std::cout << "  create -n <count> [name] [priority] - Create a batch of processes\n";
     std::cout << "  terminate <pid>         - Terminate a process\n";
+    std::cout << "  terminate <first>-<last> - Terminate every process in a PID range\n";
     std::cout << "  list                    - List all processes\n";
     std::cout << "  info <pid>              - Display process information\n";
     std::cout << "  allocate <pid> <res_id> - Allocate a resource to a process\n";
+    std::cout << "  acquire <pid> <res_id> [timeout_ms] - Wait in the background for a resource\n";
     std::cout << "  release <pid> <res_id>  - Release a resource from a process\n";
+    std::cout << "  allocate|release <pid> <type> <units> - Take or give back counted units\n";
+    std::cout << "  units [<type> <total>]  - Show counted resource units, or set a total\n";
+    std::cout << "  claim <pid> <cpu> <mem> <file> <net> <generic> - Declare a maximum claim\n";
     std::cout << "  deadlock                - Check for deadlocks\n";
     std::cout << "  status                  - Display system status\n";
     std::cout << "  resources               - List resources\n";
     std::cout << "  calculator              - Start the calculator process\n"; 
     std::cout << "  suspend <pid>           - Suspend a process\n";
     std::cout << "  resume <pid>            - Resume a suspended process\n";
+    std::cout << "  policy [name]           - Show or switch the scheduler policy\n";
+    std::cout << "  schedule [ticks]        - Run the scheduler and report throughput/fairness\n";
+    std::cout << "  simulate [n] [policy] [cpus] [seed] - Replay n process lifecycles in virtual time\n";
+    std::cout << "  events [on|off]         - Record process events, or show those recorded\n";
+    std::cout << "  pipeline [n] [ticks]    - Create, schedule, allocate, check deadlock, report\n";
     std::cout << "  exit                    - Exit the simulator\n";
 }
 
 void Simulator::handleCreateProcess(const std::vector<std::string>& args) {
-    if (args.empty()) {
-        std::cout << "Usage: create <name> [priority]\n";
+    if (args.empty() || (args[0] == "-n" && args.size() < 2)) {
+        std::cout << "Usage: create <name> [priority] | create -n <count> [name] [priority]\n";
         return;
     }
     
+    auto& pm = ProcessManager::getInstance();
+    if (args[0] == "-n") {
+        size_t count = std::stoul(args[1]);
+        std::string name = args.size() > 2 ? args[2] : "proc";
+        Priority priority = args.size() > 3 ? std::stoi(args[3]) : 0;
+
+        auto processes = pm.createProcesses(std::vector<ProcessSpec>(count, {name, priority}));
+        if (processes.size() < count) {
+            std::cout << "Failed to create " << count << " processes: not enough free PIDs\n";
+        } else if (count > 0) {
+            std::cout << "Created " << count << " processes '" << name << "' with priority "
+                      << priority << ", PIDs " << processes.front()->getPID() << " to "
+                      << processes.back()->getPID() << "\n";
+        }
+        return;
+    }
+
     std::string name = args[0];
     Priority priority = args.size() > 1 ? std::stoi(args[1]) : 0;
     
-    auto& pm = ProcessManager::getInstance();
     auto process = pm.createProcess(name, priority);
+    if (!process) {
+        std::cout << "Failed to create process: no free PIDs\n";
+        return;
+    }
     
     std::cout << "Created process '" << name << "' with PID " 
               << process->getPID() << " and priority " << priority << "\n";
@@ -248,13 +452,26 @@ void Simulator::handleCreateProcess(const std::vector<std::string>& args) {
 
 void Simulator::handleTerminateProcess(const std::vector<std::string>& args) {
     if (args.empty()) {
-        std::cout << "Usage: terminate <pid>\n";
+        std::cout << "Usage: terminate <pid> | terminate <first>-<last>\n";
         return;
     }
     
-    ProcessID pid = std::stoi(args[0]);
     auto& pm = ProcessManager::getInstance();
-    
+    size_t dash = args[0].find('-', 1);
+    if (dash != std::string::npos) {
+        ProcessID first = std::max(std::stoi(args[0].substr(0, dash)), 0);
+        ProcessID last = std::min(std::stoi(args[0].substr(dash + 1)), pm.getPidLimit() - 1);
+        std::vector<ProcessID> pids;
+        for (ProcessID pid = first; pid <= last; ++pid) {
+            pids.push_back(pid);
+        }
+
+        size_t terminated = pm.terminateProcesses(pids);
+        std::cout << "Terminated " << terminated << " processes in " << args[0] << "\n";
+        return;
+    }
+
+    ProcessID pid = std::stoi(args[0]);
     if (pm.terminateProcess(pid) == ErrorCode::SUCCESS) {
         std::cout << "Process " << pid << " terminated\n";
     } else {
@@ -277,13 +494,20 @@ void Simulator::handleProcessInfo(const std::vector<std::string>& args) {
         return;
     }
     
-    const auto& stats = process->getStats();
+    // One row, so every field is from the same moment
+    ProcessSnapshot info;
+    process->appendTo(info);
+    const ProcessStats& stats = info.stats[0];
     std::cout << "\nProcess Information:\n";
     std::cout << "PID: " << pid << "\n";
-    std::cout << "Name: " << process->getName() << "\n";
-    std::cout << "Priority: " << process->getPriority() << "\n";
-    std::cout << "State: " << toString(process->getState()) << "\n";
-    std::cout << "CPU Time: " << stats.cpu_time << "ms\n";
+    std::cout << "Name: " << info.names[0] << "\n";
+    std::cout << "Priority: " << info.priorities[0] << "\n";
+    std::cout << "State: " << toString(info.states[0]) << "\n";
+    std::cout << "CPU: " << info.cpus[0] << "\n";
+    auto milliseconds = [](uint64_t ns) { return std::to_string(ns / 1000000.0) + " ms"; };
+    std::cout << "CPU Time: " << milliseconds(stats.cpu_time) << "\n";
+    std::cout << "Ready Time: " << milliseconds(stats.ready_time) << "\n";
+    std::cout << "Wait Time: " << milliseconds(stats.wait_time) << "\n";
     std::cout << "Memory Used: " << stats.memory_used << " bytes\n";
     std::cout << "I/O Operations: " << stats.io_operations << "\n";
     std::cout << "Context Switches: " << stats.context_switches << "\n";
@@ -324,23 +548,83 @@ void Simulator::handleListResources() {
 void Simulator::handleAllocateResource(const std::vector<std::string>& args) {
     if (args.size() < 2) {
         std::cout << "Usage: allocate <pid> <resource_id>\n";
+        std::cout << "       allocate <pid> <type> <units>\n";
         return;
     }
     
     ProcessID pid = std::stoi(args[0]);
+    ResourceType type;
+    if (args.size() > 2 && parseResourceType(args[1], type)) {
+        // Units are given back when the process is retired, so a pid with
+        // no process would keep them for good
+        if (!ProcessManager::getInstance().getProcess(pid)) {
+            std::cout << "Process " << pid << " not found\n";
+            return;
+        }
+        auto units = static_cast<ResourceUnits>(std::stoul(args[2]));
+        ErrorCode result = ResourceManager::getInstance().allocate(pid, type, units);
+        if (result == ErrorCode::SUCCESS) {
+            std::cout << units << " " << toString(type) << " units allocated to process "
+                      << pid << "\n";
+        } else {
+            std::cout << "Failed to allocate " << units << " " << toString(type)
+                      << " units to process " << pid << ": " << toString(result) << "\n";
+        }
+        return;
+    }
     ResourceID rid = std::stoi(args[1]);
     
-    auto& rm = ResourceManager::getInstance();
-    if (rm.allocateResource(pid, rid) == ErrorCode::SUCCESS) {
+    // Through the process, so it knows what to give back when it ends
+    auto process = ProcessManager::getInstance().getProcess(pid);
+    if (!process) {
+        std::cout << "Process " << pid << " not found\n";
+        return;
+    }
+    if (process->requestResource(rid) == ErrorCode::SUCCESS) {
         std::cout << "Resource " << rid << " allocated to process " << pid << "\n";
     } else {
         std::cout << "Failed to allocate resource " << rid << " to process " << pid << "\n";
     }
 }
 
+void Simulator::handleAcquireResource(const std::vector<std::string>& args) {
+    if (args.size() < 2) {
+        std::cout << "Usage: acquire <pid> <resource_id> [timeout_ms]\n";
+        return;
+    }
+
+    ProcessID pid = std::stoi(args[0]);
+    ResourceID rid = std::stoi(args[1]);
+    auto timeout = args.size() > 2 ? std::chrono::milliseconds(std::stoll(args[2]))
+                                   : std::chrono::milliseconds::max();
+
+    auto process = ProcessManager::getInstance().getProcess(pid);
+    if (!process) {
+        std::cout << "Process " << pid << " not found\n";
+        return;
+    }
+
+    // Waits on its own thread so the prompt stays usable, e.g. for deadlock;
+    // a pool worker parked here could starve the commands that end the wait
+    std::cout << "Process " << pid << " waiting for resource " << rid << "\n";
+    waiters_.emplace_back([process, pid, rid, timeout] {
+        ErrorCode result = process->acquireResource(rid, timeout);
+        if (result == ErrorCode::SUCCESS) {
+            std::cout << "\nResource " << rid << " acquired by process " << pid << "\n";
+        } else {
+            std::cout << "\nProcess " << pid << " gave up waiting for resource " << rid
+                      << ": " << toString(result) << "\n";
+        }
+    });
+}
+
 void Simulator::handleStartCalculator(const std::vector<std::string>& /*args*/) {
     auto& pm = ProcessManager::getInstance();
     auto process = pm.createProcess("Calculator", 5);
+    if (!process) {
+        std::cout << "Failed to create calculator process: no free PIDs\n";
+        return;
+    }
     std::cout << "Calculator process created with PID " << process->getPID() << "\n";
 
     inCalculatorMode_ = true; // Enter calculator mode
@@ -354,20 +638,88 @@ void Simulator::handleStartCalculator(const std::vector<std::string>& /*args*/)
 void Simulator::handleReleaseResource(const std::vector<std::string>& args) {
     if (args.size() < 2) {
         std::cout << "Usage: release <pid> <resource_id>\n";
+        std::cout << "       release <pid> <type> <units>\n";
         return;
     }
     
     ProcessID pid = std::stoi(args[0]);
+    ResourceType type;
+    if (args.size() > 2 && parseResourceType(args[1], type)) {
+        auto units = static_cast<ResourceUnits>(std::stoul(args[2]));
+        if (ResourceManager::getInstance().release(pid, type, units) == ErrorCode::SUCCESS) {
+            std::cout << units << " " << toString(type) << " units released from process "
+                      << pid << "\n";
+        } else {
+            std::cout << "Failed to release " << units << " " << toString(type)
+                      << " units from process " << pid << "\n";
+        }
+        return;
+    }
     ResourceID rid = std::stoi(args[1]);
     
-    auto& rm = ResourceManager::getInstance();
-    if (rm.releaseResource(pid, rid) == ErrorCode::SUCCESS) {
+    auto process = ProcessManager::getInstance().getProcess(pid);
+    if (!process) {
+        std::cout << "Process " << pid << " not found\n";
+        return;
+    }
+    if (process->releaseResource(rid) == ErrorCode::SUCCESS) {
         std::cout << "Resource " << rid << " released from process " << pid << "\n";
     } else {
         std::cout << "Failed to release resource " << rid << " from process " << pid << "\n";
     }
 }
 
+void Simulator::handleResourceUnits(const std::vector<std::string>& args) {
+    auto& rm = ResourceManager::getInstance();
+    ResourceType type;
+    if (args.size() >= 2 && parseResourceType(args[0], type)) {
+        auto total = static_cast<ResourceUnits>(std::stoul(args[1]));
+        ErrorCode result = rm.setResourceUnits(type, total);
+        if (result != ErrorCode::SUCCESS) {
+            std::cout << "Failed to set " << toString(type) << " to " << total
+                      << " units: " << toString(result) << "\n";
+            return;
+        }
+    } else if (!args.empty()) {
+        std::cout << "Usage: units [<type> <total>]\n";
+        return;
+    }
+
+    std::cout << std::setw(7) << "Type" << " | " << std::setw(10) << "Total" << " | "
+              << std::setw(10) << "Available" << "\n";
+    std::cout << std::string(33, '-') << "\n";
+    for (size_t i = 0; i < kResourceTypeCount; ++i) {
+        auto type = static_cast<ResourceType>(i);
+        std::cout << std::setw(7) << toString(type) << " | "
+                  << std::setw(10) << rm.getTotalUnits(type) << " | "
+                  << std::setw(10) << rm.getAvailableUnits(type) << "\n";
+    }
+}
+
+void Simulator::handleDeclareClaim(const std::vector<std::string>& args) {
+    if (args.size() != kResourceTypeCount + 1) {
+        std::cout << "Usage: claim <pid> <cpu> <mem> <file> <net> <generic>\n";
+        return;
+    }
+
+    ProcessID pid = std::stoi(args[0]);
+    if (!ProcessManager::getInstance().getProcess(pid)) {
+        std::cout << "Process " << pid << " not found\n";
+        return;
+    }
+    std::vector<ResourceUnits> claim;
+    for (size_t i = 1; i < args.size(); ++i) {
+        claim.push_back(static_cast<ResourceUnits>(std::stoul(args[i])));
+    }
+    ErrorCode result = ResourceManager::getInstance().declareMaxClaim(pid, claim);
+    if (result == ErrorCode::SUCCESS) {
+        std::cout << "Maximum claim declared for process " << pid << "\n";
+    } else {
+        std::cout << "Failed to declare claim for process " << pid << ": "
+                  << toString(result) << "\n";
+    }
+}
+
 void Simulator::handleSuspendProcess(const std::vector<std::string>& args) {
     if (args.empty()) {
         std::cout << "Usage: suspend <pid>\n";
@@ -400,4 +752,190 @@ void Simulator::handleResumeProcess(const std::vector<std::string>& args) {
     }
 }
 
-} // namespace os_sim
\ No newline at end of file
+void Simulator::handleSimulateWorkload(const std::vector<std::string>& args) {
+    SimulationConfig config;
+    if (args.size() > 0) config.processes = std::stoul(args[0]);
+    if (args.size() > 1) config.policy = args[1];
+    if (args.size() > 2) config.cpus = std::stoul(args[2]);
+    if (args.size() > 3) config.seed = std::stoull(args[3]);
+    // Same offered load per CPU whatever the CPU count
+    config.mean_interarrival /= std::max<size_t>(config.cpus, 1);
+
+    SimulationResult result = WorkloadSimulation(config).run();
+
+    std::ios saved_format(nullptr);
+    saved_format.copyfmt(std::cout);
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "\nSimulated " << result.completed << " processes (" << config.policy
+              << ", " << config.cpus << " CPUs, seed " << config.seed << "):\n";
+    std::cout << "Virtual Time: " << result.end_time / 1e9 << " s in "
+              << result.wall_seconds << " s wall (" << result.events << " events)\n";
+    std::cout << "Turnaround: mean " << result.mean_turnaround_ms
+              << " ms, p99 " << result.p99_turnaround_ms << " ms\n";
+    std::cout << "Ready Wait: " << result.mean_ready_wait_ms << " ms per dispatch\n";
+    std::cout << "CPU Utilization: " << result.cpu_utilization * 100.0 << "%\n";
+    std::cout << "Dispatches: " << result.dispatches
+              << " (migrations " << result.migrations << ")\n";
+    std::cout << "Resource Waits: " << result.resource_waits << "\n";
+    std::cout << "Messages: " << result.messages_delivered << " delivered, "
+              << result.messages_dropped << " dropped\n";
+
+    std::cout.copyfmt(saved_format);
+}
+
+void Simulator::handleSchedulerPolicy(const std::vector<std::string>& args) {
+    auto& pm = ProcessManager::getInstance();
+
+    if (args.empty()) {
+        std::cout << "Scheduler policy: " << pm.getSchedulerPolicy() << "\nAvailable:";
+        for (const auto& name : schedulerPolicyNames()) {
+            std::cout << " " << name;
+        }
+        std::cout << "\n";
+        return;
+    }
+
+    if (pm.setSchedulerPolicy(args[0])) {
+        std::cout << "Scheduler policy set to " << args[0] << "\n";
+    } else {
+        std::cout << "Unknown scheduler policy '" << args[0] << "'\n";
+    }
+}
+
+void Simulator::handleRunScheduler(const std::vector<std::string>& args) {
+    size_t ticks = args.empty() ? 100 : std::stoul(args[0]);
+
+    auto& pm = ProcessManager::getInstance();
+    SchedulingReport report = pm.runScheduler(ticks);
+
+    std::ios saved_format(nullptr);
+    saved_format.copyfmt(std::cout);
+
+    std::cout << "\nScheduler run (" << pm.getSchedulerPolicy() << ", "
+              << report.cpus << " CPUs):\n";
+    std::cout << "Ticks: " << report.ticks << " (busy " << report.busy_ticks
+              << " of " << report.ticks * report.cpus << " CPU-ticks)\n";
+    std::cout << "Dispatches: " << report.dispatches << "\n";
+    std::cout << "Processes Run: " << report.processes_run << " of "
+              << report.runnable << " runnable\n";
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "Fairness (Jain): " << report.fairness << "\n";
+    std::cout << std::setprecision(1);
+    std::cout << "Cost per Tick: " << report.ns_per_tick << " ns\n";
+
+    std::cout.copyfmt(saved_format);
+}
+
+void Simulator::handleEvents(const std::vector<std::string>& args) {
+    auto& bus = ProcessManager::getInstance().getEventBus();
+    if (!args.empty() && args[0] == "on") {
+        if (event_subscriber_ < 0) {
+            event_subscriber_ = bus.subscribe();
+        }
+        std::cout << (event_subscriber_ >= 0 ? "Recording process events\n"
+                                             : "No free event subscriber slots\n");
+        return;
+    }
+    if (!args.empty() && args[0] == "off") {
+        if (event_subscriber_ >= 0) {
+            bus.unsubscribe(event_subscriber_);
+            event_subscriber_ = -1;
+        }
+        std::cout << "Stopped recording process events\n";
+        return;
+    }
+    if (event_subscriber_ < 0) {
+        std::cout << "Not recording; use 'events on' first\n";
+        return;
+    }
+
+    std::vector<ProcessEvent> events;
+    bus.poll(event_subscriber_, events);
+    uint64_t first = events.empty() ? 0 : events.front().time;
+
+    std::ios saved_format(nullptr);
+    saved_format.copyfmt(std::cout);
+    std::cout << std::fixed << std::setprecision(3);
+    for (const auto& event : events) {
+        std::cout << "+" << std::setw(10) << static_cast<int64_t>(event.time - first) / 1000.0 << " us  PID "
+                  << std::setw(5) << event.pid << "  " << toString(event.type);
+        if (event.type == ProcessEventType::STATE_CHANGED) {
+            std::cout << " " << toString(event.old_state) << " -> " << toString(event.new_state);
+        } else if (event.resource >= 0) {
+            std::cout << " resource " << event.resource;
+        }
+        std::cout << "\n";
+    }
+    std::cout.copyfmt(saved_format);
+
+    std::cout << events.size() << " events";
+    if (uint64_t dropped = bus.dropped(event_subscriber_)) {
+        std::cout << ", " << dropped << " dropped so far while the buffer was full";
+    }
+    std::cout << "\n";
+}
+
+void Simulator::handlePipeline(const std::vector<std::string>& args) {
+    size_t count = args.size() > 0 ? std::stoul(args[0]) : 64;
+    size_t ticks = args.size() > 1 ? std::stoul(args[1]) : 100;
+
+    auto& pm = ProcessManager::getInstance();
+    auto& rm = ResourceManager::getInstance();
+
+    std::vector<std::shared_ptr<Process>> processes;
+    SchedulingReport report;
+    size_t granted = 0;
+    bool deadlock = false;
+    ProcessStats stats;
+
+    // Each stage is posted by the worker that finishes the one it depends
+    // on, so only this command thread waits, on the whole graph; scheduling
+    // and allocation run side by side in the interactive lane
+    TaskOptions options;
+    options.priority = TaskPriority::INTERACTIVE;
+    TaskGraph graph;
+    auto generate = graph.addTask([&] {
+        processes = pm.createProcesses(std::vector<ProcessSpec>(count, {"pipeline", 0}));
+    }, {}, options);
+    auto schedule = graph.addTask([&] { report = pm.runScheduler(ticks); }, {generate}, options);
+    auto allocate = graph.addTask([&] {
+        auto resources = rm.getAvailableResources();
+        for (size_t i = 0; i < processes.size() && !resources.empty(); ++i) {
+            granted += processes[i]->requestResource(resources[i % resources.size()]) ==
+                       ErrorCode::SUCCESS;
+        }
+    }, {generate}, options);
+    auto detect = graph.addTask([&] { deadlock = rm.detectDeadlock(); }, {allocate}, options);
+    auto aggregate = graph.addTask([&] { stats = pm.getSystemStats(); }, {schedule, detect},
+                                   options);
+    graph.addTask([&] {
+        std::vector<ProcessID> pids;
+        for (const auto& process : processes) {
+            pids.push_back(process->getPID());
+        }
+        pm.terminateProcesses(pids);
+    }, {aggregate}, options);
+
+    try {
+        graph.run(*thread_pool_);
+        graph.wait();
+    } catch (const std::exception& e) {
+        std::cout << "Pipeline failed: " << e.what() << "\n";
+        return;
+    }
+
+    std::ios saved_format(nullptr);
+    saved_format.copyfmt(std::cout);
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "\nPipeline over " << processes.size() << " processes:\n";
+    std::cout << "Scheduled: " << report.ticks << " ticks, " << report.dispatches
+              << " dispatches, fairness " << report.fairness << "\n";
+    std::cout << "Resources Granted: " << granted << "\n";
+    std::cout << "Deadlock: " << (deadlock ? "detected" : "none") << "\n";
+    std::cout << "System CPU Time: " << stats.cpu_time / 1e6 << " ms, "
+              << stats.context_switches << " context switches\n";
+    std::cout.copyfmt(saved_format);
+}
+
+} // namespace os_sim
@@ -0,0 +1,181 @@
+// src/thread/block_pool.cpp
+#include "thread/block_pool.hpp"
+#include <mutex>
+
+namespace os_sim {
+
+namespace {
+
+constexpr size_t kSizeClasses = 4;      // 64, 128, 256, 512 bytes
+constexpr size_t kBatchSize = 64;       // Blocks moved between caches at once
+
+struct FreeBlock {
+    FreeBlock* next;
+    FreeBlock* next_batch;  // Only meaningful on the head of a batch
+    size_t batch_size;      // Only meaningful on the head of a batch
+};
+
+size_t sizeClass(size_t size) {
+    size_t block = BlockPool::kBlockAlignment;
+    size_t index = 0;
+    while (block < size) {
+        block <<= 1;
+        ++index;
+    }
+    return index;
+}
+
+size_t classBlockSize(size_t index) {
+    return BlockPool::kBlockAlignment << index;
+}
+
+// Shared between threads; only touched once per kBatchSize operations
+class GlobalBlockList {
+public:
+    FreeBlock* takeBatch(size_t index, size_t& count) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            FreeBlock* batch = batches_[index];
+            if (batch) {
+                batches_[index] = batch->next_batch;
+                count = batch->batch_size;
+                return batch;
+            }
+        }
+        count = kBatchSize;
+        return carveBatch(index);
+    }
+
+    void giveBatch(size_t index, FreeBlock* batch, size_t count) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        batch->batch_size = count;
+        batch->next_batch = batches_[index];
+        batches_[index] = batch;
+    }
+
+private:
+    FreeBlock* carveBatch(size_t index) {
+        size_t block_size = classBlockSize(index);
+        auto* chunk = static_cast<unsigned char*>(::operator new(
+            block_size * kBatchSize, std::align_val_t(BlockPool::kBlockAlignment)));
+
+        FreeBlock* head = nullptr;
+        for (size_t i = kBatchSize; i > 0; --i) {
+            auto* block = reinterpret_cast<FreeBlock*>(chunk + (i - 1) * block_size);
+            block->next = head;
+            head = block;
+        }
+        return head;
+    }
+
+    std::mutex mutex_;
+    FreeBlock* batches_[kSizeClasses] = {};
+};
+
+GlobalBlockList& globalBlocks() {
+    // Intentionally leaked: thread caches flush into it during thread exit,
+    // which may happen after static destruction has started.
+    static GlobalBlockList* list = new GlobalBlockList();
+    return *list;
+}
+
+// Set once a thread's cache has been torn down; later frees from other
+// thread_local destructors go straight to the global list.
+thread_local bool thread_cache_destroyed = false;
+
+class ThreadBlockCache {
+public:
+    ~ThreadBlockCache() {
+        thread_cache_destroyed = true;
+        for (size_t index = 0; index < kSizeClasses; ++index) {
+            while (count_[index] > 0) {
+                flushBatch(index);
+            }
+        }
+    }
+
+    void* allocate(size_t index) {
+        if (!heads_[index]) {
+            heads_[index] = globalBlocks().takeBatch(index, count_[index]);
+        }
+
+        FreeBlock* block = heads_[index];
+        heads_[index] = block->next;
+        --count_[index];
+        return block;
+    }
+
+    void deallocate(size_t index, void* ptr) {
+        auto* block = static_cast<FreeBlock*>(ptr);
+        block->next = heads_[index];
+        heads_[index] = block;
+        ++count_[index];
+
+        // Keep at most two batches locally so producer/consumer thread pairs
+        // keep recycling through the global list instead of growing it.
+        if (count_[index] > 2 * kBatchSize) {
+            flushBatch(index);
+        }
+    }
+
+private:
+    void flushBatch(size_t index) {
+        FreeBlock* batch = heads_[index];
+        FreeBlock* tail = batch;
+        size_t taken = 1;
+        while (taken < kBatchSize && tail->next) {
+            tail = tail->next;
+            ++taken;
+        }
+
+        heads_[index] = tail->next;
+        count_[index] -= taken;
+        tail->next = nullptr;
+        globalBlocks().giveBatch(index, batch, taken);
+    }
+
+    FreeBlock* heads_[kSizeClasses] = {};
+    size_t count_[kSizeClasses] = {};
+};
+
+ThreadBlockCache& threadBlocks() {
+    thread_local ThreadBlockCache cache;
+    return cache;
+}
+
+} // namespace
+
+void* BlockPool::allocate(size_t size) {
+    if (size > kMaxBlockSize) {
+        return ::operator new(size, std::align_val_t(kBlockAlignment));
+    }
+    if (thread_cache_destroyed) {
+        size_t index = sizeClass(size);
+        size_t count = 0;
+        FreeBlock* batch = globalBlocks().takeBatch(index, count);
+        if (count > 1) {
+            globalBlocks().giveBatch(index, batch->next, count - 1);
+        }
+        return batch;
+    }
+    return threadBlocks().allocate(sizeClass(size));
+}
+
+void BlockPool::deallocate(void* ptr, size_t size) noexcept {
+    if (!ptr) {
+        return;
+    }
+    if (size > kMaxBlockSize) {
+        ::operator delete(ptr, std::align_val_t(kBlockAlignment));
+        return;
+    }
+    if (thread_cache_destroyed) {
+        auto* block = static_cast<FreeBlock*>(ptr);
+        block->next = nullptr;
+        globalBlocks().giveBatch(sizeClass(size), block, 1);
+        return;
+    }
+    threadBlocks().deallocate(sizeClass(size), ptr);
+}
+
+} // namespace os_sim
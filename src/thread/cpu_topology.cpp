@@ -0,0 +1,117 @@
+// src/thread/cpu_topology.cpp
+#include "thread/cpu_topology.hpp"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace os_sim {
+
+const CpuTopology& CpuTopology::get() {
+    static CpuTopology topology;
+    return topology;
+}
+
+CpuTopology::CpuTopology()
+    : node_count_(1)
+{
+#ifdef __linux__
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &allowed)) {
+                cpus_.push_back(cpu);
+            }
+        }
+    }
+
+    // NUMA nodes are listed as /sys/devices/system/node/node<N>/cpulist
+    int max_cpu = cpus_.empty() ? 0 : cpus_.back();
+    cpu_nodes_.assign(max_cpu + 1, 0);
+    for (int node = 0; node < 1024; ++node) {
+        std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        if (!file) {
+            break;  // Node ids are dense in practice
+        }
+
+        std::string list;
+        std::getline(file, list);
+        for (int cpu : parseCpuList(list)) {
+            if (cpu >= 0 && cpu <= max_cpu) {
+                cpu_nodes_[cpu] = node;
+            }
+        }
+        node_count_ = std::max<size_t>(node_count_, node + 1);
+    }
+#endif
+
+    if (cpus_.empty()) {
+        unsigned count = std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned cpu = 0; cpu < count; ++cpu) {
+            cpus_.push_back(static_cast<int>(cpu));
+        }
+        cpu_nodes_.assign(count, 0);
+    }
+
+    std::stable_sort(cpus_.begin(), cpus_.end(), [this](int a, int b) {
+        return getNodeOf(a) < getNodeOf(b);
+    });
+}
+
+int CpuTopology::getNodeOf(int cpu) const {
+    if (cpu < 0 || static_cast<size_t>(cpu) >= cpu_nodes_.size()) {
+        return 0;
+    }
+    return cpu_nodes_[cpu];
+}
+
+std::vector<int> CpuTopology::parseCpuList(const std::string& list) {
+    std::vector<int> cpus;
+    std::istringstream stream(list);
+    std::string range;
+
+    while (std::getline(stream, range, ',')) {
+        if (range.empty()) {
+            continue;
+        }
+
+        size_t dash = range.find('-');
+        try {
+            if (dash == std::string::npos) {
+                cpus.push_back(std::stoi(range));
+            } else {
+                int first = std::stoi(range.substr(0, dash));
+                int last = std::stoi(range.substr(dash + 1));
+                for (int cpu = first; cpu <= last; ++cpu) {
+                    cpus.push_back(cpu);
+                }
+            }
+        } catch (const std::exception&) {
+            // Skip malformed entries
+        }
+    }
+
+    return cpus;
+}
+
+bool CpuTopology::pinCurrentThread(int cpu) {
+#ifdef __linux__
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+} // namespace os_sim
@@ -0,0 +1,100 @@
+// src/thread/cycle_clock.cpp
+#include "thread/cycle_clock.hpp"
+#include <chrono>
+#include <thread>
+
+#ifdef __linux__
+#include <time.h>
+#endif
+
+#ifdef __x86_64__
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+
+namespace os_sim {
+
+namespace {
+
+#ifdef __x86_64__
+bool hasInvariantTsc() {
+    unsigned eax, ebx, ecx, edx;
+    if (!__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) || eax < 0x80000007) {
+        return false;
+    }
+    __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx);
+    return (edx & (1u << 8)) != 0;
+}
+#endif
+
+// A rate outside this range means the measurement went wrong. Within it
+// the fixed-point rate fits in 28 bits, and now() stays exact for 2^60
+// cycles.
+constexpr double kMinTscGhz = 0.1;
+constexpr double kMaxTscGhz = 10.0;
+constexpr unsigned kRateShift = 24;
+
+} // namespace
+
+uint64_t CycleClock::now() {
+#ifdef __x86_64__
+    const Calibration& rate = calibration();
+    if (rate.tsc) {
+        // A core whose TSC lags the calibrating one can read below the
+        // base; clamp that to the base instead of wrapping to the far future
+        int64_t delta = static_cast<int64_t>(__rdtsc() - rate.base_cycles);
+        uint64_t cycles = delta > 0 ? static_cast<uint64_t>(delta) : 0;
+        // (cycles * rate) >> kRateShift in halves, without 128-bit types
+        uint64_t high = (cycles >> 32) * rate.ns_per_cycle << (32 - kRateShift);
+        uint64_t low = ((cycles & 0xffffffffu) * rate.ns_per_cycle) >> kRateShift;
+        return rate.base_ns + high + low;
+    }
+#endif
+    return monotonicNow();
+}
+
+bool CycleClock::usesTsc() {
+    return calibration().tsc;
+}
+
+const CycleClock::Calibration& CycleClock::calibration() {
+    static const Calibration calibration = [] {
+        Calibration result;
+#ifdef __x86_64__
+        if (!hasInvariantTsc()) {
+            return result;
+        }
+
+        // A few milliseconds keeps the error to a few parts per million
+        uint64_t start_ns = monotonicNow();
+        uint64_t start_cycles = __rdtsc();
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        uint64_t end_ns = monotonicNow();
+        uint64_t end_cycles = __rdtsc();
+
+        double ghz = static_cast<double>(end_cycles - start_cycles) / (end_ns - start_ns);
+        if (ghz < kMinTscGhz || ghz > kMaxTscGhz) {
+            return result;
+        }
+        result.tsc = true;
+        result.base_cycles = end_cycles;
+        result.base_ns = end_ns;
+        result.ns_per_cycle = static_cast<uint64_t>((uint64_t{1} << kRateShift) / ghz);
+#endif
+        return result;
+    }();
+    return calibration;
+}
+
+uint64_t CycleClock::monotonicNow() {
+#ifdef __linux__
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000u + static_cast<uint64_t>(ts.tv_nsec);
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+} // namespace os_sim
@@ -0,0 +1,82 @@
+// src/thread/latency_histogram.cpp
+#include "thread/latency_histogram.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace os_sim {
+
+size_t LatencyHistogram::bucketOf(uint64_t value) {
+    if (value < kSubBuckets) {
+        return static_cast<size_t>(value);
+    }
+
+    // Exponent picks the power of two, the next kSubBucketBits bits below
+    // the leading one pick the linear bucket inside it
+    size_t exponent = 63 - static_cast<size_t>(__builtin_clzll(value));
+    size_t sub = static_cast<size_t>(value >> (exponent - kSubBucketBits)) & (kSubBuckets - 1);
+    return (exponent - kSubBucketBits + 1) * kSubBuckets + sub;
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(size_t bucket) {
+    if (bucket < kSubBuckets) {
+        return bucket;
+    }
+
+    size_t exponent = bucket / kSubBuckets + kSubBucketBits - 1;
+    size_t sub = bucket % kSubBuckets;
+    size_t shift = exponent - kSubBucketBits;
+    uint64_t lower = (uint64_t(kSubBuckets) + sub) << shift;
+    return lower + ((uint64_t(1) << shift) - 1);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        bump(buckets_[i], other.buckets_[i].load(std::memory_order_relaxed));
+    }
+    bump(count_, other.count_.load(std::memory_order_relaxed));
+    bump(sum_, other.sum_.load(std::memory_order_relaxed));
+    max_.store(std::max(max_.load(std::memory_order_relaxed),
+                        other.max_.load(std::memory_order_relaxed)),
+               std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::percentile(double quantile) const {
+    // Counted from the buckets rather than count_, which a concurrent
+    // writer may have bumped independently
+    uint64_t total = 0;
+    for (const auto& bucket : buckets_) {
+        total += bucket.load(std::memory_order_relaxed);
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    auto rank = static_cast<uint64_t>(std::ceil(quantile * static_cast<double>(total)));
+    rank = std::max<uint64_t>(rank, 1);
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        seen += buckets_[i].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            return std::min(bucketUpperBound(i), max_.load(std::memory_order_relaxed));
+        }
+    }
+    return max_.load(std::memory_order_relaxed);
+}
+
+LatencySummary LatencyHistogram::summarize() const {
+    LatencySummary summary;
+    summary.count = count_.load(std::memory_order_relaxed);
+    if (summary.count == 0) {
+        return summary;
+    }
+
+    summary.mean = static_cast<double>(sum_.load(std::memory_order_relaxed)) / summary.count;
+    summary.p50 = percentile(0.50);
+    summary.p99 = percentile(0.99);
+    summary.p999 = percentile(0.999);
+    summary.max = max_.load(std::memory_order_relaxed);
+    return summary;
+}
+
+} // namespace os_sim
@@ -0,0 +1,160 @@
+// src/thread/task_graph.cpp
+#include "thread/task_graph.hpp"
+#include <stdexcept>
+
+namespace os_sim {
+
+TaskGraph::~TaskGraph() {
+    // Always goes through the mutex, even if running_ already reads false,
+    // so a worker still inside finishRun() is done with the graph
+    try {
+        wait();
+    } catch (...) {
+        // A failed run is reported through wait(); nothing to do here
+    }
+}
+
+TaskGraph::NodeId TaskGraph::addNode(Task work, const NodeId* dependencies, size_t count,
+                                     const TaskOptions& options) {
+    if (running_) {
+        throw std::runtime_error("addTask on running TaskGraph");
+    }
+
+    NodeId id = nodes_.size();
+    for (size_t i = 0; i < count; ++i) {
+        if (dependencies[i] >= id) {
+            throw std::out_of_range("TaskGraph dependency refers to unknown node");
+        }
+    }
+
+    Node& node = nodes_.emplace_back();
+    node.work = std::move(work);
+    node.options = options;
+    for (size_t i = 0; i < count; ++i) {
+        nodes_[dependencies[i]].successors.push_back(id);
+        ++node.predecessor_count;
+    }
+    return id;
+}
+
+void TaskGraph::precede(NodeId before, NodeId after) {
+    if (running_) {
+        throw std::runtime_error("precede on running TaskGraph");
+    }
+    if (before >= nodes_.size() || after >= nodes_.size()) {
+        throw std::out_of_range("TaskGraph edge refers to unknown node");
+    }
+
+    nodes_[before].successors.push_back(after);
+    ++nodes_[after].predecessor_count;
+}
+
+void TaskGraph::checkAcyclic() const {
+    // Kahn's algorithm; only needed because precede() can add back edges
+    std::vector<size_t> indegree(nodes_.size());
+    std::vector<NodeId> ready;
+    for (NodeId id = 0; id < nodes_.size(); ++id) {
+        indegree[id] = nodes_[id].predecessor_count;
+        if (indegree[id] == 0) {
+            ready.push_back(id);
+        }
+    }
+
+    size_t visited = 0;
+    while (!ready.empty()) {
+        NodeId id = ready.back();
+        ready.pop_back();
+        ++visited;
+        for (NodeId successor : nodes_[id].successors) {
+            if (--indegree[successor] == 0) {
+                ready.push_back(successor);
+            }
+        }
+    }
+
+    if (visited != nodes_.size()) {
+        throw std::runtime_error("TaskGraph contains a cycle");
+    }
+}
+
+void TaskGraph::run(ThreadPool& pool) {
+    if (running_) {
+        throw std::runtime_error("TaskGraph is already running");
+    }
+    checkAcyclic();
+
+    if (nodes_.empty()) {
+        return;
+    }
+
+    pool_ = &pool;
+    error_ = nullptr;
+    failed_ = false;
+    remaining_ = nodes_.size();
+    for (auto& node : nodes_) {
+        node.pending.store(node.predecessor_count, std::memory_order_relaxed);
+    }
+    running_ = true;
+
+    for (NodeId id = 0; id < nodes_.size(); ++id) {
+        if (nodes_[id].predecessor_count == 0) {
+            schedule(id);
+        }
+    }
+}
+
+void TaskGraph::wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return !running_.load(); });
+
+    if (error_) {
+        std::rethrow_exception(error_);
+    }
+}
+
+void TaskGraph::schedule(NodeId id) {
+    try {
+        pool_->postWithOptions(nodes_[id].options, [this, id]() { runNode(id); });
+    } catch (const std::runtime_error&) {
+        // Pool stopped under us; run inline so the graph still completes
+        runNode(id);
+    }
+}
+
+void TaskGraph::runNode(NodeId id) {
+    Node& node = nodes_[id];
+
+    if (!failed_) {
+        try {
+            node.work();
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!error_) {
+                error_ = std::current_exception();
+            }
+            failed_ = true;
+        }
+    }
+
+    // Successors are released even after a failure so the run drains;
+    // they observe failed_ and skip their work.
+    for (NodeId successor : node.successors) {
+        if (nodes_[successor].pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            schedule(successor);
+        }
+    }
+
+    if (remaining_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        finishRun();
+    }
+}
+
+void TaskGraph::finishRun() {
+    // Notify under the lock: a waiter may destroy the graph as soon as it
+    // observes running_ == false and reacquires the mutex.
+    std::lock_guard<std::mutex> lock(mutex_);
+    running_ = false;
+    done_.notify_all();
+}
+
+} // namespace os_sim
@@ -1,42 +1,429 @@
 // src/thread/thread_pool.cpp
 #include "thread/thread_pool.hpp"
+#include "thread/cpu_topology.hpp"
 #include <algorithm>
 #include <stdexcept>
 
 namespace os_sim {
 
-ThreadPool::ThreadPool(size_t num_threads)
-    : stop_(false)
+namespace {
+
+// Identifies the pool and deque owned by the calling worker thread, so that
+// tasks submitted from inside a task land on the local deque.
+thread_local const ThreadPool* current_pool = nullptr;
+thread_local size_t current_worker = 0;
+
+using Clock = std::chrono::steady_clock;
+
+// Implicit deadline for lane tasks submitted without one, so that they take
+// part in earliest-deadline-first selection against explicit deadlines
+constexpr Clock::duration kLaneBudget[] = {
+    std::chrono::milliseconds(1),
+    std::chrono::milliseconds(10),
+    std::chrono::milliseconds(100),
+};
+
+// A lane whose oldest task has waited this long is served ahead of the
+// higher lanes, so background work cannot starve
+constexpr Clock::duration kLaneAgingThreshold[] = {
+    Clock::duration::zero(),
+    std::chrono::milliseconds(50),
+    std::chrono::milliseconds(200),
+};
+
+// Yields a producer spends retrying a full bounded ring before it sleeps
+constexpr uint32_t kBoundedPushRetries = 16;
+
+// Work-stealing workers look at the shared lanes at least this often even
+// while their own deque has work
+constexpr uint32_t kSharedCheckInterval = 32;
+
+// Counters with a single writer (the owning worker) need no read-modify-write
+void bump(std::atomic<uint64_t>& counter, uint64_t amount) {
+    counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+uint64_t nextRandom(uint64_t& state) {
+    // xorshift64
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+} // namespace
+
+struct ThreadPool::TaskNode {
+    Task task;
+    TaskNode* next{nullptr};
+    Clock::time_point enqueue_time;
+    Clock::time_point deadline;
+    TaskPriority priority{TaskPriority::NORMAL};
+    bool has_deadline{false};
+
+    static TaskNode* create(Task&& task, const TaskOptions& options = TaskOptions()) {
+        void* block = BlockPool::allocate(sizeof(TaskNode));
+        auto* node = new (block) TaskNode();
+        node->task = std::move(task);
+        node->enqueue_time = Clock::now();
+        node->priority = options.priority;
+        node->has_deadline = options.deadline != Clock::time_point();
+        node->deadline = node->has_deadline
+            ? options.deadline
+            : node->enqueue_time + kLaneBudget[static_cast<size_t>(options.priority)];
+        return node;
+    }
+
+    bool isLocalCandidate() const {
+        return priority == TaskPriority::NORMAL && !has_deadline;
+    }
+
+    // Heap order for Lane::deadline_heap (earliest deadline on top)
+    static bool laterDeadline(const TaskNode* lhs, const TaskNode* rhs) {
+        return lhs->deadline > rhs->deadline;
+    }
+
+    static void destroy(TaskNode* node) noexcept {
+        node->~TaskNode();
+        BlockPool::deallocate(node, sizeof(TaskNode));
+    }
+};
+
+struct ThreadPool::ChunkedJob {
+    ChunkFunction function;
+    void* context;
+    size_t begin;
+    size_t end;
+    size_t grain;
+    size_t chunk_count;
+
+    std::atomic<size_t> next_chunk{0};
+    std::atomic<size_t> remaining{0};
+    std::atomic<bool> failed{false};
+
+    std::mutex mutex;
+    std::condition_variable done;
+    std::exception_ptr error;
+
+    // Claims and runs chunks until none are left. Helpers that only get
+    // scheduled after the caller has returned find nothing to claim and
+    // never touch function/context.
+    void work() {
+        size_t chunk;
+        while ((chunk = next_chunk.fetch_add(1)) < chunk_count) {
+            if (!failed.load(std::memory_order_relaxed)) {
+                size_t first = begin + chunk * grain;
+                size_t last = std::min(end, first + grain);
+                try {
+                    function(context, chunk, first, last);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (!error) {
+                        error = std::current_exception();
+                    }
+                    failed = true;
+                }
+            }
+
+            if (remaining.fetch_sub(1) == 1) {
+                std::lock_guard<std::mutex> lock(mutex);
+                done.notify_all();
+            }
+        }
+    }
+};
+
+ThreadPool::ThreadPool(size_t num_threads, ThreadPoolMode mode)
+    : ThreadPool([num_threads, mode] {
+          ThreadPoolConfig config;
+          config.min_threads = num_threads;
+          config.max_threads = num_threads;
+          config.mode = mode;
+          return config;
+      }())
+{}
+
+ThreadPool::ThreadPool(const ThreadPoolConfig& config)
+    : config_(config)
+    , stop_(false)
     , paused_(false)
-    , active_threads_(0)
+    , timer_wheel_(config.timer_tick)
 {
-    workers_.reserve(num_threads);
+    // Growth waits for queued work to age, so with no worker the first
+    // task would always stall
+    config_.min_threads = std::max<size_t>(config_.min_threads, 1);
+    config_.max_threads = std::max(config_.max_threads, config_.min_threads);
+    if (config_.mode == ThreadPoolMode::BOUNDED_QUEUE) {
+        bounded_queue_ = std::make_unique<MpmcQueue<TaskNode*>>(config_.queue_capacity);
+    }
 
-    for (size_t i = 0; i < num_threads; ++i) {
-        workers_.emplace_back(&ThreadPool::workerFunction, this);
+    workers_.reserve(config_.max_threads);
+    for (size_t i = 0; i < config_.max_threads; ++i) {
+        auto worker = std::make_unique<Worker>();
+        worker->steal_seed = 0x9E3779B97F4A7C15ULL * (i + 1);
+        workers_.push_back(std::move(worker));
+    }
+    assignPlacement();
+
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        for (size_t i = 0; i < config_.min_threads; ++i) {
+            spawnWorker();
+        }
+    }
+    if (config_.max_threads > config_.min_threads) {
+        monitor_thread_ = std::thread(&ThreadPool::monitorFunction, this);
     }
 }
 
 ThreadPool::~ThreadPool() {
     shutdown();
+
+    // Anything pushed while shutdown raced past the stop_ check never ran
+    if (bounded_queue_) {
+        TaskNode* node = nullptr;
+        while (bounded_queue_->tryPop(node)) {
+            TaskNode::destroy(node);
+        }
+    }
 }
 
 void ThreadPool::shutdown() {
+    // Stop the timer thread first so that no timer posts into a stopping pool
+    {
+        std::lock_guard<std::mutex> lock(timer_mutex_);
+        timer_stop_ = true;
+    }
+    timer_condition_.notify_all();
+    if (timer_thread_.joinable()) {
+        timer_thread_.join();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(monitor_mutex_);
+        monitor_stop_ = true;
+    }
+    monitor_condition_.notify_all();
+    if (monitor_thread_.joinable()) {
+        monitor_thread_.join();
+    }
+
     {
         std::unique_lock<std::mutex> lock(queue_mutex_);
         stop_ = true;
     }
-    
+
     condition_.notify_all();
     pause_condition_.notify_all();
-    
-    for (std::thread& worker : workers_) {
-        if (worker.joinable()) {
-            worker.join();
+    space_condition_.notify_all();
+
+    // No worker can be spawned once stop_ is set
+    for (auto& worker : workers_) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
         }
     }
 }
 
+void ThreadPool::assignPlacement() {
+    const CpuTopology& topology = CpuTopology::get();
+    const std::vector<int>* cpus = nullptr;
+
+    switch (config_.affinity) {
+        case AffinityPolicy::ROUND_ROBIN:
+            // Topology lists CPUs node by node, so low slots (the ones an
+            // elastic pool fills first) share a node
+            cpus = &topology.getCpus();
+            break;
+        case AffinityPolicy::CPU_LIST:
+            cpus = &config_.cpu_list;
+            break;
+        case AffinityPolicy::NONE:
+            return;
+    }
+
+    if (cpus->empty()) {
+        return;
+    }
+
+    for (size_t index = 0; index < workers_.size(); ++index) {
+        Worker& worker = *workers_[index];
+        worker.cpu = (*cpus)[index % cpus->size()];
+        worker.node = topology.getNodeOf(worker.cpu);
+    }
+}
+
+void ThreadPool::applyPlacement(size_t index) {
+    Worker& worker = *workers_[index];
+    if (worker.cpu >= 0) {
+        worker.pinned = CpuTopology::pinCurrentThread(worker.cpu);
+    }
+}
+
+std::vector<WorkerPlacement> ThreadPool::getWorkerPlacement() const {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    std::vector<WorkerPlacement> placement;
+    placement.reserve(workers_.size());
+
+    for (size_t index = 0; index < workers_.size(); ++index) {
+        const Worker& worker = *workers_[index];
+        WorkerPlacement entry;
+        entry.worker = index;
+        entry.cpu = worker.cpu;
+        entry.node = worker.node;
+        entry.running = worker.running;
+        entry.pinned = worker.pinned.load();
+        placement.push_back(entry);
+    }
+
+    return placement;
+}
+
+bool ThreadPool::spawnWorker() {
+    // Caller holds queue_mutex_
+    if (stop_ || live_workers_.load() >= config_.max_threads) {
+        return false;
+    }
+
+    for (size_t index = 0; index < workers_.size(); ++index) {
+        Worker& worker = *workers_[index];
+        if (worker.running) {
+            continue;
+        }
+
+        // A retired worker releases queue_mutex_ right before returning,
+        // so this join does not wait on anything we hold.
+        if (worker.thread.joinable()) {
+            worker.thread.join();
+        }
+
+        worker.running = true;
+        ++live_workers_;
+        // The bounded ring is polled like a deque, so it shares the loop
+        if (config_.mode != ThreadPoolMode::SHARED_QUEUE) {
+            worker.thread = std::thread(&ThreadPool::workStealingWorkerFunction, this, index);
+        } else {
+            worker.thread = std::thread(&ThreadPool::workerFunction, this, index);
+        }
+        return true;
+    }
+
+    return false;
+}
+
+void ThreadPool::maybeGrow(Clock::duration observed_wait) {
+    if (observed_wait < config_.grow_wait_threshold ||
+        live_workers_.load() >= config_.max_threads ||
+        sleeping_workers_.load() + spinning_workers_.load() > 0 ||
+        !hasQueuedWork()) {
+        return;
+    }
+
+    // One spawn at a time; a burst of slow tasks should not fork a thread each
+    if (growing_.exchange(true)) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        spawnWorker();
+    }
+    growing_ = false;
+}
+
+void ThreadPool::wakeMonitor() {
+    // Pairs with the store to monitor_idle_ before the monitor re-checks
+    // the queues, so either it sees the new work or we see it idle
+    if (!monitor_idle_.load()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(monitor_mutex_);
+        monitor_idle_ = false;
+    }
+    monitor_condition_.notify_one();
+}
+
+void ThreadPool::monitorFunction() {
+    std::unique_lock<std::mutex> lock(monitor_mutex_);
+    while (!monitor_stop_) {
+        if (!hasQueuedWork()) {
+            monitor_idle_ = true;
+            if (!hasQueuedWork()) {
+                monitor_condition_.wait(lock, [this] {
+                    return monitor_stop_ || !monitor_idle_.load();
+                });
+            }
+            monitor_idle_ = false;
+            continue;
+        }
+
+        // Submit and dequeue only grow when they run; if no task finishes
+        // for a whole threshold while work waits and no worker is free,
+        // every worker is busy or blocked and nothing else will add one
+        uint64_t completed = completedTaskCount();
+        monitor_condition_.wait_for(lock, config_.grow_wait_threshold, [this] {
+            return monitor_stop_;
+        });
+        if (!monitor_stop_ && completedTaskCount() == completed) {
+            lock.unlock();
+            maybeGrow(config_.grow_wait_threshold);
+            lock.lock();
+        }
+    }
+}
+
+uint64_t ThreadPool::completedTaskCount() const {
+    uint64_t completed = 0;
+    for (const auto& worker : workers_) {
+        for (size_t lane = 0; lane < kLaneCount; ++lane) {
+            completed += worker->stats.completed[lane].load(std::memory_order_relaxed);
+        }
+    }
+    return completed;
+}
+
+bool ThreadPool::hasQueuedWork() const {
+    return shared_queue_size_.load() > 0 || local_queue_size_.load() > 0;
+}
+
+bool ThreadPool::spinForWork() {
+    if (config_.spin_duration.count() <= 0) {
+        return false;
+    }
+
+    ++spinning_workers_;
+    bool found = false;
+    auto deadline = Clock::now() + config_.spin_duration;
+    while (Clock::now() < deadline) {
+        if (stop_ || hasQueuedWork()) {
+            found = true;
+            break;
+        }
+        std::this_thread::yield();
+    }
+    --spinning_workers_;
+    return found;
+}
+
+bool ThreadPool::parkWorker(std::unique_lock<std::mutex>& lock, size_t index) {
+    // Caller holds queue_mutex_ through lock
+    ++sleeping_workers_;
+    bool woken = condition_.wait_for(lock, config_.idle_timeout, [this] {
+        return stop_ || hasQueuedWork();
+    });
+    --sleeping_workers_;
+
+    bool exiting = stop_ && !hasQueuedWork();
+    bool retiring = !woken && live_workers_.load() > config_.min_threads;
+    if (exiting || retiring) {
+        workers_[index]->running = false;
+        --live_workers_;
+        return false;
+    }
+    return true;
+}
+
 void ThreadPool::pause() {
     std::unique_lock<std::mutex> lock(queue_mutex_);
     paused_ = true;
@@ -51,58 +438,703 @@ void ThreadPool::resume() {
 }
 
 size_t ThreadPool::getActiveThreadCount() const {
-    return active_threads_;
+    size_t active = 0;
+    for (const auto& worker : workers_) {
+        active += worker->stats.active.load(std::memory_order_relaxed);
+    }
+    return active;
 }
 
 size_t ThreadPool::getQueuedTaskCount() const {
-    std::lock_guard<std::mutex> lock(queue_mutex_);
-    return tasks_.size();
+    return shared_queue_size_.load() + local_queue_size_.load();
 }
 
 double ThreadPool::getAverageWaitTime() const {
-    uint64_t completed = total_tasks_completed_.load();
+    uint64_t completed = 0;
+    uint64_t wait_time = 0;
+    for (const auto& worker : workers_) {
+        for (size_t lane = 0; lane < kLaneCount; ++lane) {
+            completed += worker->stats.completed[lane].load(std::memory_order_relaxed);
+            wait_time += worker->stats.wait_time[lane].load(std::memory_order_relaxed);
+        }
+    }
     if (completed == 0) return 0.0;
-    
-    return static_cast<double>(total_wait_time_.load()) / completed;
+
+    // Wait times are kept in nanoseconds, reported in milliseconds
+    return static_cast<double>(wait_time) / 1e6 / completed;
 }
 
-void ThreadPool::workerFunction() {
-    while (true) {
-        std::function<void()> task;
-        
+LaneStats ThreadPool::getLaneStats(TaskPriority priority) const {
+    size_t index = static_cast<size_t>(priority);
+    LaneStats stats;
+    stats.queued_tasks = lanes_[index].size.load();
+
+    uint64_t wait_time = 0;
+    for (const auto& worker : workers_) {
+        stats.completed_tasks += worker->stats.completed[index].load(std::memory_order_relaxed);
+        stats.missed_deadlines += worker->stats.missed_deadlines[index].load(std::memory_order_relaxed);
+        wait_time += worker->stats.wait_time[index].load(std::memory_order_relaxed);
+    }
+
+    if (priority == TaskPriority::NORMAL) {
+        // Local deques only ever hold plain NORMAL tasks
+        stats.queued_tasks += local_queue_size_.load();
+    }
+    if (stats.completed_tasks > 0) {
+        stats.average_wait_time = static_cast<double>(wait_time) / 1e6 / stats.completed_tasks;
+    }
+    return stats;
+}
+
+ThreadPoolMetrics ThreadPool::getMetrics() const {
+    ThreadPoolMetrics metrics;
+    metrics.workers = live_workers_.load();
+    metrics.queued_tasks = getQueuedTaskCount();
+
+    LatencyHistogram wait_histogram;
+    LatencyHistogram run_histogram;
+    for (const auto& worker : workers_) {
+        const WorkerStats& stats = worker->stats;
+        metrics.active_threads += stats.active.load(std::memory_order_relaxed);
+        for (size_t lane = 0; lane < kLaneCount; ++lane) {
+            metrics.completed_tasks += stats.completed[lane].load(std::memory_order_relaxed);
+        }
+        metrics.failed_tasks += stats.failed.load(std::memory_order_relaxed);
+        metrics.stolen_tasks += stats.stolen.load(std::memory_order_relaxed);
+        wait_histogram.merge(stats.wait_histogram);
+        run_histogram.merge(stats.run_histogram);
+    }
+
+    metrics.dropped_timer_tasks = timer_drops_.load(std::memory_order_relaxed);
+    metrics.queue_wait = wait_histogram.summarize();
+    metrics.execution = run_histogram.summarize();
+    return metrics;
+}
+
+void ThreadPool::submit(Task task, const TaskOptions& options, bool may_block) {
+    TaskNode* node = TaskNode::create(std::move(task), options);
+
+    if (bounded_queue_ && node->isLocalCandidate()) {
+        pushBounded(node, may_block);
+        wakeMonitor();
+        return;
+    }
+
+    if (config_.mode == ThreadPoolMode::WORK_STEALING && current_pool == this &&
+        node->isLocalCandidate()) {
+        // Submitted from one of our own workers: keep it local
+        if (stop_) {
+            TaskNode::destroy(node);
+            throw std::runtime_error("Cannot enqueue on stopped ThreadPool");
+        }
+
+        // Count first so a thief can never decrement below zero
+        ++local_queue_size_;
+        workers_[current_worker]->deque.push(node);
+
+        // Pairs with the increment of sleeping_workers_ under queue_mutex_
+        // in workStealingWorkerFunction so a parking worker cannot miss it.
+        if (sleeping_workers_.load() > 0) {
+            std::lock_guard<std::mutex> lock(queue_mutex_);
+            condition_.notify_one();
+        }
+        wakeMonitor();
+        return;
+    }
+
+    Clock::duration oldest_wait = Clock::duration::zero();
+    {
+        std::unique_lock<std::mutex> lock(queue_mutex_);
+
+        if (stop_) {
+            TaskNode::destroy(node);
+            throw std::runtime_error("Cannot enqueue on stopped ThreadPool");
+        }
+
+        pushShared(node);
+
+        if (sleeping_workers_.load() == 0 && live_workers_.load() < config_.max_threads) {
+            for (const Lane& lane : lanes_) {
+                if (lane.head) {
+                    oldest_wait = std::max(oldest_wait, node->enqueue_time - lane.head->enqueue_time);
+                }
+            }
+        }
+    }
+
+    // Parked workers register under queue_mutex_, so reading the count after
+    // the push cannot miss one
+    if (sleeping_workers_.load() > 0) {
+        condition_.notify_one();
+    }
+    wakeMonitor();
+    maybeGrow(oldest_wait);
+}
+
+void ThreadPool::submitBulk(Task* tasks, size_t count) {
+    if (count == 0) {
+        return;
+    }
+
+    // Build the whole chain before touching any queue
+    TaskNode* head = TaskNode::create(std::move(tasks[0]));
+    TaskNode* tail = head;
+    for (size_t i = 1; i < count; ++i) {
+        tail->next = TaskNode::create(std::move(tasks[i]));
+        tail = tail->next;
+    }
+
+    auto discard = [head]() {
+        for (TaskNode* node = head; node;) {
+            TaskNode* next = node->next;
+            TaskNode::destroy(node);
+            node = next;
+        }
+    };
+
+    if (bounded_queue_) {
+        for (TaskNode* node = head; node;) {
+            TaskNode* next = node->next;
+            node->next = nullptr;
+            try {
+                pushBounded(node);
+            } catch (...) {
+                head = next;  // The rest was never queued
+                discard();
+                throw;
+            }
+            node = next;
+        }
+        wakeMonitor();
+        return;
+    }
+
+    if (config_.mode == ThreadPoolMode::WORK_STEALING && current_pool == this) {
+        if (stop_) {
+            discard();
+            throw std::runtime_error("Cannot enqueue on stopped ThreadPool");
+        }
+
+        local_queue_size_ += count;
+        auto& deque = workers_[current_worker]->deque;
+        for (TaskNode* node = head; node;) {
+            TaskNode* next = node->next;
+            node->next = nullptr;
+            deque.push(node);
+            node = next;
+        }
+
+        if (sleeping_workers_.load() > 0) {
+            std::lock_guard<std::mutex> lock(queue_mutex_);
+            condition_.notify_all();
+        }
+        wakeMonitor();
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(queue_mutex_);
+
+        if (stop_) {
+            lock.unlock();
+            discard();
+            throw std::runtime_error("Cannot enqueue on stopped ThreadPool");
+        }
+
+        // Bulk work always lands in the NORMAL lane's FIFO
+        Lane& lane = lanes_[static_cast<size_t>(TaskPriority::NORMAL)];
+        if (lane.tail) {
+            lane.tail->next = head;
+        } else {
+            lane.head = head;
+        }
+        lane.tail = tail;
+        lane.size += count;
+        shared_queue_size_ += count;
+    }
+
+    if (count >= live_workers_.load()) {
+        condition_.notify_all();
+    } else {
+        for (size_t i = 0; i < count; ++i) {
+            condition_.notify_one();
+        }
+    }
+    wakeMonitor();
+}
+
+size_t ThreadPool::chunkGrain(size_t count, size_t grain) const {
+    if (grain > 0) {
+        return grain;
+    }
+    // A few chunks per participant leaves room for load balancing
+    size_t participants = live_workers_.load() + 1;
+    return std::max<size_t>(1, count / (participants * 4));
+}
+
+void ThreadPool::runChunked(size_t begin, size_t end, size_t grain,
+                            ChunkFunction function, void* context) {
+    if (begin >= end) {
+        return;
+    }
+
+    grain = chunkGrain(end - begin, grain);
+    size_t chunk_count = (end - begin + grain - 1) / grain;
+    size_t helpers = std::min(live_workers_.load(), chunk_count - 1);
+
+    if (helpers == 0 || stop_) {
+        for (size_t chunk = 0; chunk < chunk_count; ++chunk) {
+            size_t first = begin + chunk * grain;
+            function(context, chunk, first, std::min(end, first + grain));
+        }
+        return;
+    }
+
+    auto job = std::allocate_shared<ChunkedJob>(PoolAllocator<ChunkedJob>());
+    job->function = function;
+    job->context = context;
+    job->begin = begin;
+    job->end = end;
+    job->grain = grain;
+    job->chunk_count = chunk_count;
+    job->remaining = chunk_count;
+
+    std::vector<Task> batch;
+    batch.reserve(helpers);
+    for (size_t i = 0; i < helpers; ++i) {
+        batch.emplace_back([job]() { job->work(); });
+    }
+
+    try {
+        submitBulk(batch.data(), helpers);
+    } catch (const std::runtime_error&) {
+        // Pool stopped concurrently; the caller simply does all the work
+    }
+
+    job->work();
+
+    {
+        std::unique_lock<std::mutex> lock(job->mutex);
+        job->done.wait(lock, [&job] { return job->remaining.load() == 0; });
+    }
+
+    if (job->error) {
+        std::rethrow_exception(job->error);
+    }
+}
+
+void ThreadPool::pushBounded(TaskNode* node, bool may_block) {
+    if (stop_) {
+        TaskNode::destroy(node);
+        throw std::runtime_error("Cannot enqueue on stopped ThreadPool");
+    }
+
+    // Count first so a consumer can never decrement below zero
+    ++local_queue_size_;
+
+    uint32_t retries = 0;
+    while (!bounded_queue_->tryPush(node)) {
+        if (current_pool == this) {
+            // Backpressure on our own worker: run it here rather than wait
+            --local_queue_size_;
+            runTask(current_worker, node);
+            return;
+        }
+
+        if (config_.queue_full_policy == QueueFullPolicy::REJECT || !may_block) {
+            --local_queue_size_;
+            TaskNode::destroy(node);
+            throw std::runtime_error("ThreadPool queue is full");
+        }
+
+        // Consumers usually free a slot within a few yields
+        if (++retries <= kBoundedPushRetries) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        // Sleep until the ring has drained to half, so producers are woken
+        // in one batch instead of once per freed slot. Pairs with the check
+        // in popBounded: either the consumer sees us registered, or we see
+        // the space it freed.
+        ++blocked_producers_;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
         {
             std::unique_lock<std::mutex> lock(queue_mutex_);
-            
-            // Wait for work or shutdown signal
-            condition_.wait(lock, [this] {
-                return stop_ || !tasks_.empty();
+            space_condition_.wait(lock, [this] {
+                return stop_ || bounded_queue_->size() <= bounded_queue_->capacity() / 2;
             });
-            
+        }
+        --blocked_producers_;
+        retries = 0;
+
+        if (stop_) {
+            --local_queue_size_;
+            TaskNode::destroy(node);
+            throw std::runtime_error("Cannot enqueue on stopped ThreadPool");
+        }
+    }
+
+    if (sleeping_workers_.load() > 0) {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        condition_.notify_one();
+    }
+}
+
+ThreadPool::TaskNode* ThreadPool::popBounded() {
+    TaskNode* node = nullptr;
+    if (!bounded_queue_->tryPop(node)) {
+        return nullptr;
+    }
+    --local_queue_size_;
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (blocked_producers_.load() > 0 &&
+        bounded_queue_->size() <= bounded_queue_->capacity() / 2) {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        space_condition_.notify_all();
+    }
+    return node;
+}
+
+void ThreadPool::pushShared(TaskNode* node) {
+    // Caller holds queue_mutex_
+    Lane& lane = lanes_[static_cast<size_t>(node->priority)];
+
+    if (node->has_deadline) {
+        lane.deadline_heap.push_back(node);
+        std::push_heap(lane.deadline_heap.begin(), lane.deadline_heap.end(), TaskNode::laterDeadline);
+    } else {
+        if (lane.tail) {
+            lane.tail->next = node;
+        } else {
+            lane.head = node;
+        }
+        lane.tail = node;
+    }
+
+    ++lane.size;
+    ++shared_queue_size_;
+}
+
+size_t ThreadPool::selectLane(Clock::time_point now) const {
+    // Caller holds queue_mutex_
+    size_t selected = kLaneCount;
+    Clock::duration worst_overdue = Clock::duration::zero();
+
+    for (size_t index = 0; index < kLaneCount; ++index) {
+        const Lane& lane = lanes_[index];
+        if (lane.size.load(std::memory_order_relaxed) == 0) {
+            continue;
+        }
+        if (selected == kLaneCount) {
+            selected = index;  // Highest non-empty lane by default
+        }
+        if (index == 0) {
+            continue;
+        }
+
+        // Aging: serve the lower lane whose oldest task is most overdue
+        Clock::time_point oldest = Clock::time_point::max();
+        if (lane.head) {
+            oldest = lane.head->enqueue_time;
+        }
+        if (!lane.deadline_heap.empty()) {
+            oldest = std::min(oldest, lane.deadline_heap.front()->enqueue_time);
+        }
+
+        Clock::duration overdue = (now - oldest) - kLaneAgingThreshold[index];
+        if (overdue > worst_overdue) {
+            worst_overdue = overdue;
+            selected = index;
+        }
+    }
+
+    return selected;
+}
+
+ThreadPool::TaskNode* ThreadPool::popShared() {
+    // Caller holds queue_mutex_
+    if (shared_queue_size_.load(std::memory_order_relaxed) == 0) {
+        return nullptr;
+    }
+
+    size_t index = selectLane(Clock::now());
+    if (index == kLaneCount) {
+        return nullptr;
+    }
+    Lane& lane = lanes_[index];
+
+    // Earliest deadline first between the FIFO head and the deadline heap
+    TaskNode* node = nullptr;
+    bool from_heap = !lane.deadline_heap.empty() &&
+                     (!lane.head || lane.deadline_heap.front()->deadline < lane.head->deadline);
+
+    if (from_heap) {
+        std::pop_heap(lane.deadline_heap.begin(), lane.deadline_heap.end(), TaskNode::laterDeadline);
+        node = lane.deadline_heap.back();
+        lane.deadline_heap.pop_back();
+    } else {
+        node = lane.head;
+        lane.head = node->next;
+        if (!lane.head) {
+            lane.tail = nullptr;
+        }
+        node->next = nullptr;
+    }
+
+    --lane.size;
+    --shared_queue_size_;
+    return node;
+}
+
+void ThreadPool::workerFunction(size_t index) {
+    applyPlacement(index);
+
+    while (true) {
+        TaskNode* node = nullptr;
+
+        // Back-to-back tasks are picked up without a park/unpark round trip
+        if (!hasQueuedWork()) {
+            spinForWork();
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex_);
+
+            // Wait for work or shutdown signal; exits on shutdown or when
+            // retired after the idle timeout
+            while (!stop_ && !hasQueuedWork()) {
+                if (!parkWorker(lock, index)) {
+                    return;
+                }
+            }
+
             // Check if we should stop
-            if (stop_ && tasks_.empty()) {
+            if (stop_ && !hasQueuedWork()) {
+                workers_[index]->running = false;
+                --live_workers_;
                 return;
             }
-            
+
             // Check if pool is paused
             while (paused_ && !stop_) {
                 pause_condition_.wait(lock);
             }
-            
+
             // Get next task
-            if (!tasks_.empty()) {
-                task = std::move(tasks_.front());
-                tasks_.pop();
-                ++active_threads_;
-            }
+            node = popShared();
         }
-        
+
         // Execute task
-        if (task) {
-            task();
-            --active_threads_;
-            ++total_tasks_completed_;
+        if (node) {
+            runTask(index, node);
+        }
+    }
+}
+
+void ThreadPool::workStealingWorkerFunction(size_t index) {
+    current_pool = this;
+    current_worker = index;
+    applyPlacement(index);
+
+    while (true) {
+        if (paused_) {
+            std::unique_lock<std::mutex> lock(queue_mutex_);
+            while (paused_ && !stop_) {
+                pause_condition_.wait(lock);
+            }
+        }
+
+        if (TaskNode* node = findTask(index)) {
+            runTask(index, node);
+            continue;
+        }
+
+        if (spinForWork()) {
+            continue;
+        }
+
+        // Nothing to run anywhere, park until new work arrives
+        std::unique_lock<std::mutex> lock(queue_mutex_);
+        if (!parkWorker(lock, index)) {
+            break;
+        }
+    }
+
+    current_pool = nullptr;
+}
+
+ThreadPool::TaskNode* ThreadPool::findTask(size_t index) {
+    Worker& queue = *workers_[index];
+
+    // 1. Interactive work, and periodically anything in the shared lanes so
+    //    aged and deadline tasks are not stuck behind a busy local deque
+    bool check_shared = ++queue.tasks_since_shared_check >= kSharedCheckInterval ||
+        lanes_[static_cast<size_t>(TaskPriority::INTERACTIVE)].size.load(
+            std::memory_order_relaxed) > 0;
+    if (check_shared && shared_queue_size_.load(std::memory_order_relaxed) > 0) {
+        queue.tasks_since_shared_check = 0;
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        if (TaskNode* shared = popShared()) {
+            return shared;
+        }
+    }
+
+    // 2. Own deque, newest first for cache locality; in BOUNDED_QUEUE mode
+    //    the shared ring takes its place
+    if (bounded_queue_) {
+        if (TaskNode* bounded = popBounded()) {
+            return bounded;
+        }
+    } else if (TaskNode* local = queue.deque.pop()) {
+        --local_queue_size_;
+        return local;
+    }
+
+    // 3. Tasks injected from outside the pool
+    if (shared_queue_size_.load(std::memory_order_relaxed) > 0) {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        if (TaskNode* shared = popShared()) {
+            return shared;
+        }
+    }
+
+    // 4. Oldest work from a peer
+    if (config_.mode == ThreadPoolMode::WORK_STEALING) {
+        return stealTask(index);
+    }
+    return nullptr;
+}
+
+ThreadPool::TaskNode* ThreadPool::stealTask(size_t index) {
+    size_t count = workers_.size();
+    if (count < 2) {
+        return nullptr;
+    }
+
+    // Peers on our own NUMA node first, then across sockets. Unpinned
+    // workers all report node 0, which makes this a single pass.
+    int home_node = workers_[index]->node;
+    size_t start = nextRandom(workers_[index]->steal_seed) % count;
+    for (int pass = 0; pass < 2; ++pass) {
+        for (size_t i = 0; i < count; ++i) {
+            size_t victim = (start + i) % count;
+            if (victim == index ||
+                (workers_[victim]->node == home_node) != (pass == 0)) {
+                continue;
+            }
+
+            if (TaskNode* stolen = workers_[victim]->deque.steal()) {
+                --local_queue_size_;
+                bump(workers_[index]->stats.stolen, 1);
+                return stolen;
+            }
+        }
+    }
+
+    return nullptr;
+}
+
+void ThreadPool::runTask(size_t index, TaskNode* node) {
+    WorkerStats& stats = workers_[index]->stats;
+    size_t lane = static_cast<size_t>(node->priority);
+
+    auto start_time = Clock::now();
+    auto wait_time = start_time - node->enqueue_time;
+    auto wait_ns = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(wait_time).count());
+    bump(stats.wait_time[lane], wait_ns);
+    stats.wait_histogram.record(wait_ns);
+    if (node->has_deadline && start_time > node->deadline) {
+        bump(stats.missed_deadlines[lane], 1);
+    }
+
+    // Work is queuing up faster than it drains: add a worker
+    maybeGrow(wait_time);
+
+    stats.active.store(true, std::memory_order_relaxed);
+    try {
+        node->task();
+    } catch (...) {
+        // Futures capture their own exceptions; this only swallows
+        // failures from post() so the worker survives.
+        bump(stats.failed, 1);
+    }
+    stats.active.store(false, std::memory_order_relaxed);
+
+    auto run_time = Clock::now() - start_time;
+    stats.run_histogram.record(static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(run_time).count()));
+    bump(stats.completed[lane], 1);
+
+    TaskNode::destroy(node);
+}
+
+TimerHandle ThreadPool::scheduleTimer(Clock::time_point when, Clock::duration period, Task task) {
+    std::lock_guard<std::mutex> lock(timer_mutex_);
+    if (timer_stop_ || stop_) {
+        throw std::runtime_error("Cannot schedule timer on stopped ThreadPool");
+    }
+
+    if (!timer_thread_.joinable()) {
+        timer_thread_ = std::thread(&ThreadPool::timerFunction, this);
+    }
+
+    TimerHandle handle{timer_wheel_.schedule(when, std::move(task), period)};
+
+    // Only wake the timer thread if it is sleeping past the new expiry
+    if (timer_wheel_.nextWakeup() < timer_wakeup_) {
+        timer_condition_.notify_one();
+    }
+    return handle;
+}
+
+bool ThreadPool::cancelTimer(TimerHandle handle) {
+    std::lock_guard<std::mutex> lock(timer_mutex_);
+    return timer_wheel_.cancel(handle.id);
+}
+
+size_t ThreadPool::getPendingTimerCount() const {
+    std::lock_guard<std::mutex> lock(timer_mutex_);
+    return timer_wheel_.size();
+}
+
+void ThreadPool::timerFunction() {
+    std::unique_lock<std::mutex> lock(timer_mutex_);
+
+    std::vector<std::pair<Task, TaskOptions>> due;
+    while (!timer_stop_) {
+        // Due callbacks only queue their tasks, so running them under
+        // timer_mutex_ keeps cancelTimer exact without holding it for long
+        timer_wheel_.advance(Clock::now());
+
+        // Posted unlocked and without blocking: a full ring must not stall
+        // the wheel, or shutdown, which takes timer_mutex_ before stop_
+        if (!timer_due_.empty()) {
+            due.swap(timer_due_);
+            lock.unlock();
+            for (auto& [task, options] : due) {
+                try {
+                    submit(std::move(task), options, false);
+                } catch (...) {
+                    timer_drops_.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            due.clear();
+            lock.lock();
+            if (timer_stop_) {
+                break;
+            }
+        }
+
+        timer_wakeup_ = timer_wheel_.nextWakeup();
+        if (timer_wakeup_ == Clock::time_point::max()) {
+            timer_condition_.wait(lock);
+        } else {
+            timer_condition_.wait_until(lock, timer_wakeup_);
         }
     }
 }
 
-} // namespace os_sim
\ No newline at end of file
+} // namespace os_sim
@@ -0,0 +1,243 @@
+// src/thread/timer_wheel.cpp
+#include "thread/timer_wheel.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace os_sim {
+
+namespace {
+
+constexpr uint64_t kNoEvent = UINT64_MAX;
+
+size_t highestBit(uint64_t value) {
+    return 63 - static_cast<size_t>(__builtin_clzll(value));
+}
+
+size_t lowestBit(uint64_t value) {
+    return static_cast<size_t>(__builtin_ctzll(value));
+}
+
+} // namespace
+
+TimerWheel::TimerWheel(Clock::duration tick, Clock::time_point origin)
+    : tick_(std::max(tick, Clock::duration(1)))
+    , origin_(origin)
+{
+    std::fill(std::begin(heads_), std::end(heads_), kNone);
+}
+
+uint64_t TimerWheel::toTick(Clock::time_point when) const {
+    if (when <= origin_) {
+        return 0;
+    }
+    // Round up so a timer never fires before its time
+    auto elapsed = static_cast<uint64_t>((when - origin_).count());
+    auto tick = static_cast<uint64_t>(tick_.count());
+    return (elapsed + tick - 1) / tick;
+}
+
+uint64_t TimerWheel::schedule(Clock::time_point when, Task task, Clock::duration period) {
+    uint32_t index = free_head_;
+    if (index != kNone) {
+        free_head_ = entry(index).next;
+    } else {
+        if (entry_count_ == kNone) {
+            throw std::length_error("TimerWheel is full");
+        }
+        if ((entry_count_ & (kChunkSize - 1)) == 0) {
+            chunks_.push_back(std::make_unique<Entry[]>(kChunkSize));
+        }
+        index = entry_count_++;
+    }
+
+    Entry& timer = entry(index);
+    uint64_t expiry = std::max(toTick(when), current_ + 1);
+    timer.expiry = std::min(expiry, current_ + kMaxTicks);
+    timer.period = 0;
+    if (period > Clock::duration::zero()) {
+        auto ticks = (period.count() + tick_.count() - 1) / tick_.count();
+        timer.period = std::min<uint64_t>(static_cast<uint64_t>(ticks), kMaxTicks);
+    }
+    timer.task = std::move(task);
+    timer.armed = true;
+    ++count_;
+    link(index);
+
+    return (static_cast<uint64_t>(timer.generation) << 32) | index;
+}
+
+bool TimerWheel::cancel(uint64_t id) {
+    auto index = static_cast<uint32_t>(id);
+    auto generation = static_cast<uint32_t>(id >> 32);
+    if (index >= entry_count_) {
+        return false;
+    }
+
+    Entry& timer = entry(index);
+    if (!timer.armed || timer.generation != generation) {
+        return false;
+    }
+
+    unlink(index);
+    release(index);
+    return true;
+}
+
+size_t TimerWheel::advance(Clock::time_point now) {
+    uint64_t target = now <= origin_
+        ? 0
+        : static_cast<uint64_t>((now - origin_).count()) / static_cast<uint64_t>(tick_.count());
+    size_t fired = 0;
+
+    while (current_ < target) {
+        uint64_t next = nextEventTick();
+        if (next > target) {
+            // Only empty slots in between; nothing to cascade or fire
+            current_ = target;
+            break;
+        }
+
+        current_ = next;
+        for (size_t level = kLevels - 1; level > 0; --level) {
+            uint64_t mask = (uint64_t(1) << (level * kSlotBits)) - 1;
+            if ((current_ & mask) == 0) {
+                cascade(level);
+            }
+        }
+        fired += fireSlot(current_ & (kSlots - 1));
+    }
+
+    return fired;
+}
+
+TimerWheel::Clock::time_point TimerWheel::nextWakeup() const {
+    uint64_t next = nextEventTick();
+    auto limit = static_cast<uint64_t>((Clock::time_point::max() - origin_) / tick_);
+    if (next == kNoEvent || next >= limit) {
+        return Clock::time_point::max();
+    }
+    return origin_ + tick_ * static_cast<Clock::rep>(next);
+}
+
+void TimerWheel::link(uint32_t index) {
+    Entry& timer = entry(index);
+
+    // The level is picked from the distance to the expiry; the slot from the
+    // expiry itself, so the slot is reached exactly when the expiry's block
+    // at that level begins.
+    uint64_t delta = timer.expiry - current_;
+    size_t level = delta < kSlots ? 0 : highestBit(delta) / kSlotBits;
+    size_t slot = (timer.expiry >> (level * kSlotBits)) & (kSlots - 1);
+    size_t bucket = level * kSlots + slot;
+
+    timer.bucket = static_cast<uint16_t>(bucket);
+    timer.prev = kNone;
+    timer.next = heads_[bucket];
+    if (timer.next != kNone) {
+        entry(timer.next).prev = index;
+    }
+    heads_[bucket] = index;
+    occupied_[level] |= uint64_t(1) << slot;
+}
+
+void TimerWheel::unlink(uint32_t index) {
+    Entry& timer = entry(index);
+    size_t bucket = timer.bucket;
+
+    if (timer.prev != kNone) {
+        entry(timer.prev).next = timer.next;
+    } else {
+        heads_[bucket] = timer.next;
+    }
+    if (timer.next != kNone) {
+        entry(timer.next).prev = timer.prev;
+    }
+
+    if (heads_[bucket] == kNone) {
+        occupied_[bucket / kSlots] &= ~(uint64_t(1) << (bucket % kSlots));
+    }
+}
+
+void TimerWheel::release(uint32_t index) {
+    Entry& timer = entry(index);
+    timer.task.reset();
+    timer.armed = false;
+    if (++timer.generation == 0) {
+        timer.generation = 1;  // Keep ids non-zero
+    }
+    timer.next = free_head_;
+    free_head_ = index;
+    --count_;
+}
+
+void TimerWheel::cascade(size_t level) {
+    size_t slot = (current_ >> (level * kSlotBits)) & (kSlots - 1);
+    size_t bucket = level * kSlots + slot;
+
+    uint32_t index = heads_[bucket];
+    heads_[bucket] = kNone;
+    occupied_[level] &= ~(uint64_t(1) << slot);
+
+    while (index != kNone) {
+        uint32_t next = entry(index).next;
+        link(index);
+        index = next;
+    }
+}
+
+size_t TimerWheel::fireSlot(size_t slot) {
+    uint32_t index = heads_[slot];
+    heads_[slot] = kNone;
+    occupied_[0] &= ~(uint64_t(1) << slot);
+
+    size_t fired = 0;
+    while (index != kNone) {
+        Entry& timer = entry(index);
+        uint32_t next = timer.next;
+
+        try {
+            timer.task();
+        } catch (...) {
+            // Same contract as ThreadPool::post
+        }
+        ++fired;
+
+        if (timer.period > 0) {
+            timer.expiry += timer.period;
+            link(index);
+        } else {
+            release(index);
+        }
+        index = next;
+    }
+    return fired;
+}
+
+uint64_t TimerWheel::nextEventTick() const {
+    if (count_ == 0) {
+        return kNoEvent;
+    }
+
+    // For each level, the first tick after current_ at which an occupied
+    // slot is reached: a timer at level 0, a cascade above it
+    uint64_t next = kNoEvent;
+    for (size_t level = 0; level < kLevels; ++level) {
+        uint64_t bits = occupied_[level];
+        if (bits == 0) {
+            continue;
+        }
+
+        size_t shift = level * kSlotBits;
+        size_t position = (current_ >> shift) & (kSlots - 1);
+        uint64_t rotation = (current_ >> (shift + kSlotBits)) << (shift + kSlotBits);
+
+        uint64_t later = position + 1 < kSlots ? bits & (~uint64_t(0) << (position + 1)) : 0;
+        uint64_t candidate = later
+            ? rotation + (uint64_t(lowestBit(later)) << shift)
+            : rotation + (uint64_t(1) << (shift + kSlotBits)) + (uint64_t(lowestBit(bits)) << shift);
+        next = std::min(next, candidate);
+    }
+    return next;
+}
+
+} // namespace os_sim